@@ -0,0 +1,237 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "EdgeReader.h"
+
+#define READ_BLOCK (1 << 20)
+
+// structs --------------------------------------------------------------------
+
+// Private Scanner type: a cursor over the whole input held in memory.
+typedef struct Scanner {
+    const char *path;
+    const char *pos;
+    const char *end;
+    int line;
+} Scanner;
+
+// Private Helper Functions ---------------------------------------------------
+
+// Helper function declarations.
+void readerError(Scanner *sc, const char *message);
+char *loadFile(const char *path, size_t *length, bool *mapped);
+bool skipBlanks(Scanner *sc);
+int scanInt(Scanner *sc);
+void endLine(Scanner *sc);
+
+// Reports an error at the scanner's current line and exits.
+void readerError(Scanner *sc, const char *message) {
+    fprintf(stderr, "Reader Error: %s:%d: %s\n", sc->path, sc->line, message);
+    exit(EXIT_FAILURE);
+}
+
+// Returns the contents of the file at path, memory-mapped if possible and read in
+// READ_BLOCK sized chunks otherwise. Sets *mapped to tell the caller how to release it.
+char *loadFile(const char *path, size_t *length, bool *mapped) {
+    struct stat info;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Unable to open file %s for reading\n", path);
+        exit(EXIT_FAILURE);
+    }
+
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+        void *data = mmap(NULL, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED) {
+            posix_madvise(data, (size_t) info.st_size, POSIX_MADV_SEQUENTIAL);
+            close(fd);
+            *length = (size_t) info.st_size;
+            *mapped = true;
+            return data;
+        }
+    }
+
+    size_t capacity = READ_BLOCK;
+    size_t used = 0;
+    char *data = malloc(capacity);
+    while (data != NULL) {
+        if (capacity - used < READ_BLOCK) {
+            capacity *= 2;
+            char *grown = realloc(data, capacity);
+            if (grown == NULL) {
+                free(data);
+                data = NULL;
+                break;
+            }
+            data = grown;
+        }
+        ssize_t got = read(fd, data + used, READ_BLOCK);
+        if (got < 0) {
+            fprintf(stderr, "Unable to read file %s\n", path);
+            exit(EXIT_FAILURE);
+        }
+        if (got == 0) {
+            break;
+        }
+        used += (size_t) got;
+    }
+    if (data == NULL) {
+        fprintf(stderr, "Reader Error: out of memory reading %s\n", path);
+        exit(EXIT_FAILURE);
+    }
+    close(fd);
+    *length = used;
+    *mapped = false;
+    return data;
+}
+
+// Skips spaces, tabs, carriage returns and empty lines.
+// Returns false if the end of the input was reached.
+bool skipBlanks(Scanner *sc) {
+    while (sc->pos < sc->end) {
+        char c = *sc->pos;
+        if (c == '\n') {
+            sc->line += 1;
+        } else if (c != ' ' && c != '\t' && c != '\r') {
+            return true;
+        }
+        sc->pos += 1;
+    }
+    return false;
+}
+
+// Parses a non-negative decimal integer at the current position, which must
+// not be preceded by a line break on the same logical line.
+int scanInt(Scanner *sc) {
+    while (sc->pos < sc->end && (*sc->pos == ' ' || *sc->pos == '\t' || *sc->pos == '\r')) {
+        sc->pos += 1;
+    }
+    if (sc->pos == sc->end || *sc->pos == '\n') {
+        readerError(sc, "expected two integers on this line");
+    }
+    if (*sc->pos < '0' || *sc->pos > '9') {
+        readerError(sc, "expected a non-negative integer");
+    }
+
+    long long value = 0;
+    while (sc->pos < sc->end && *sc->pos >= '0' && *sc->pos <= '9') {
+        value = 10*value + (*sc->pos - '0');
+        if (value > INT_MAX) {
+            readerError(sc, "integer out of range");
+        }
+        sc->pos += 1;
+    }
+    return (int) value;
+}
+
+// Requires the rest of the current line to be blank and moves past it.
+void endLine(Scanner *sc) {
+    while (sc->pos < sc->end && (*sc->pos == ' ' || *sc->pos == '\t' || *sc->pos == '\r')) {
+        sc->pos += 1;
+    }
+    if (sc->pos < sc->end) {
+        if (*sc->pos != '\n') {
+            readerError(sc, "unexpected text after the end of the line");
+        }
+        sc->pos += 1;
+        sc->line += 1;
+    }
+}
+
+// Exported functions ---------------------------------------------------------
+
+// Parses the edge-list text file at path into the number of vertices *n and the
+// arc arrays *sources and *targets, and returns the number of arcs.
+int readEdges(const char *path, int *n, int **sources, int **targets) {
+    if (path == NULL) {
+        fprintf(stderr, "Reader Error: calling readEdges() with NULL path\n");
+        exit(EXIT_FAILURE);
+    }
+
+    size_t length;
+    bool mapped;
+    char *data = loadFile(path, &length, &mapped);
+    Scanner sc = {path, data, data + length, 1};
+
+    if (!skipBlanks(&sc)) {
+        readerError(&sc, "missing number of vertices");
+    }
+    *n = scanInt(&sc);
+    endLine(&sc);
+
+    // Guesses the arc count from the file length, assuming typical lines of about 16 bytes.
+    size_t capacity = length/16 + 16;
+    int *src = (int *) malloc(capacity*sizeof(int));
+    int *dst = (int *) malloc(capacity*sizeof(int));
+    if (src == NULL || dst == NULL) {
+        fprintf(stderr, "Reader Error: out of memory reading %s\n", path);
+        exit(EXIT_FAILURE);
+    }
+
+    int arcs = 0;
+    bool terminated = false;
+    while (skipBlanks(&sc)) {
+        int u = scanInt(&sc);
+        int v = scanInt(&sc);
+        if (u == 0 && v == 0) {
+            terminated = true;
+            break;
+        }
+        if (u < 1 || u > *n || v < 1 || v > *n) {
+            readerError(&sc, "vertex out of range");
+        }
+        endLine(&sc);
+        if ((size_t) arcs == capacity) {
+            if (capacity >= INT_MAX/2) {
+                readerError(&sc, "too many arcs");
+            }
+            capacity *= 2;
+            src = (int *) realloc(src, capacity*sizeof(int));
+            dst = (int *) realloc(dst, capacity*sizeof(int));
+            if (src == NULL || dst == NULL) {
+                fprintf(stderr, "Reader Error: out of memory reading %s\n", path);
+                exit(EXIT_FAILURE);
+            }
+        }
+        src[arcs] = u;
+        dst[arcs] = v;
+        arcs += 1;
+    }
+    if (!terminated) {
+        readerError(&sc, "missing terminating \"0 0\" line");
+    }
+
+    if (mapped) {
+        munmap(data, length);
+    } else {
+        free(data);
+    }
+
+    *sources = src;
+    *targets = dst;
+    return arcs;
+}
+
+// Reads a graph in the edge-list text format from the file at path and returns it.
+Graph readGraph(const char *path) {
+    if (path == NULL) {
+        fprintf(stderr, "Reader Error: calling readGraph() with NULL path\n");
+        exit(EXIT_FAILURE);
+    }
+
+    int n;
+    int *sources;
+    int *targets;
+    int arcs = readEdges(path, &n, &sources, &targets);
+    Graph G = newGraphFromEdges(n, sources, targets, arcs);
+    free(sources);
+    free(targets);
+    return G;
+}
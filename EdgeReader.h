@@ -0,0 +1,23 @@
+#ifndef EDGEREADER_H_INCLUDE_
+#define EDGEREADER_H_INCLUDE_
+
+#include "Graph.h"
+
+// Exported functions ---------------------------------------------------------
+
+// readGraph()
+// Reads a graph in the edge-list text format from the file at path and returns it.
+// The first line holds the number of vertices n; each following line holds one arc
+// "u v" with 1 <= u, v <= n, and the line "0 0" ends the list.
+// The file is memory-mapped when possible and read in large blocks otherwise.
+// On a malformed line or an out-of-range vertex, reports the file name and line
+// number to stderr and exits.
+Graph readGraph(const char *path);
+
+// readEdges()
+// Parses the file at path like readGraph(), but instead of building a Graph sets *n
+// to the number of vertices and *sources and *targets to newly allocated arrays
+// holding the arcs, which the caller frees, and returns the number of arcs.
+int readEdges(const char *path, int *n, int **sources, int **targets);
+
+#endif
@@ -1,104 +1,459 @@
+#define _POSIX_C_SOURCE 200809L
 #include "Graph.h"
+#include "EdgeReader.h"
+#include "Writer.h"
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/resource.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#define SCC_KOSARAJU 0
+#define SCC_PEARCE 1
+#define SCC_PARALLEL 2
+
+#define OUTPUT_COMPONENTS 0
+#define OUTPUT_CONDENSATION 1
+#define OUTPUT_MAP 2
+
+#define MAX_PHASES 16
+#define MAX_COUNTERS 16
+
+// Timers and counters collected with --stats, one entry per phase of the run.
+// Nothing is measured unless enabled is set.
+typedef struct Stats {
+    bool enabled;
+    int phases;
+    const char *phase_name[MAX_PHASES];
+    double phase_seconds[MAX_PHASES];
+    long long phase_heap[MAX_PHASES];
+    int counters;
+    const char *counter_name[MAX_COUNTERS];
+    long long counter[MAX_COUNTERS];
+    double start;
+    double phase_start;
+    long long heap_start;
+} Stats;
+
+// Returns the current monotonic time in seconds.
+double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec*1e-9;
+}
+
+// Returns the number of heap bytes currently allocated, or 0 where the C library
+// cannot tell.
+long long heapInUse(void) {
+#ifdef __GLIBC__
+    struct mallinfo2 info = mallinfo2();
+    return (long long) info.uordblks + (long long) info.hblkhd;
+#else
+    return 0;
+#endif
+}
+
+// Starts timing the phase called name.
+void beginPhase(Stats *S, const char *name) {
+    if (!S->enabled || S->phases == MAX_PHASES) {
+        return;
+    }
+    S->phase_name[S->phases] = name;
+    S->phase_start = now();
+    S->heap_start = heapInUse();
+}
+
+// Ends the phase started last, recording its time and the change in heap bytes.
+void endPhase(Stats *S) {
+    if (!S->enabled || S->phases == MAX_PHASES) {
+        return;
+    }
+    S->phase_seconds[S->phases] = now() - S->phase_start;
+    S->phase_heap[S->phases] = heapInUse() - S->heap_start;
+    S->phases += 1;
+}
+
+// Records the counter called name.
+void addCounter(Stats *S, const char *name, long long value) {
+    if (!S->enabled || S->counters == MAX_COUNTERS) {
+        return;
+    }
+    S->counter_name[S->counters] = name;
+    S->counter[S->counters] = value;
+    S->counters += 1;
+}
+
+// Prints the phases and counters in S as one JSON object on a line of stderr.
+void printStats(Stats *S) {
+    if (!S->enabled) {
+        return;
+    }
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    fprintf(stderr, "{\"phases\": [");
+    for (int i = 0; i < S->phases; i += 1) {
+        fprintf(stderr, "%s{\"name\": \"%s\", \"seconds\": %.6f, \"heap_bytes\": %lld}",
+                (i > 0) ? ", " : "", S->phase_name[i], S->phase_seconds[i], S->phase_heap[i]);
+    }
+    fprintf(stderr, "], \"counters\": {");
+    for (int i = 0; i < S->counters; i += 1) {
+        fprintf(stderr, "%s\"%s\": %lld", (i > 0) ? ", " : "", S->counter_name[i], S->counter[i]);
+    }
+    fprintf(stderr, "}, \"total_seconds\": %.6f, \"peak_rss_kib\": %ld}\n", now() - S->start, usage.ru_maxrss);
+}
+
+// Writes the components described by component[1..n] to W, in component order,
+// listing the members of each component in increasing vertex order.
+void printComponents(Writer W, int n, int *component, int count) {
+    int *offsets = (int *) calloc(count + 2, sizeof(int));
+    int *members = (int *) malloc((n > 0 ? n : 1)*sizeof(int));
+    for (int v = 1; v < n + 1; v += 1) {
+        offsets[component[v] + 1] += 1;
+    }
+    for (int c = 1; c < count + 1; c += 1) {
+        offsets[c + 1] += offsets[c];
+    }
+    for (int v = 1; v < n + 1; v += 1) {
+        members[offsets[component[v]]] = v;
+        offsets[component[v]] += 1;
+    }
+
+    writeString(W, "G contains ");
+    writeInt(W, count);
+    writeString(W, " strongly connected components:\n");
+    int start = 0;
+    for (int c = 1; c < count + 1; c += 1) {
+        writeString(W, "Component ");
+        writeInt(W, c);
+        writeString(W, ": ");
+        for (int i = start; i < offsets[c]; i += 1) {
+            writeInt(W, members[i]);
+            writeChar(W, ' ');
+        }
+        writeChar(W, '\n');
+        start = offsets[c];
+    }
+    free(offsets);
+    free(members);
+}
+
+// Writes one "vertex component" line per vertex of G to W.
+void printComponentMap(Writer W, int n, int *component) {
+    for (int v = 1; v < n + 1; v += 1) {
+        writeInt(W, v);
+        writeChar(W, ' ');
+        writeInt(W, component[v]);
+        writeChar(W, '\n');
+    }
+}
+
+// Writes the component DAG of G and the size of every component to W.
+void printCondensation(Writer W, Graph G, int *component, int count) {
+    int *sizes = (int *) malloc((count + 1)*sizeof(int));
+    Graph C = condensation(G, component, count, sizes);
+
+    writeString(W, "\nComponent sizes:\n");
+    for (int c = 1; c < count + 1; c += 1) {
+        writeInt(W, c);
+        writeString(W, ": ");
+        writeInt(W, sizes[c]);
+        writeChar(W, '\n');
+    }
+    writeString(W, "\nComponent DAG of G (");
+    writeInt(W, getSize(C));
+    writeString(W, " arcs):\n");
+    writeGraph(W, C);
+
+    freeGraph(&C);
+    free(sizes);
+}
+
+// Finds the SCC's of G by running DFS on G and over the reversed arcs of G, writing
+// component ids 1, 2, ... in topological order into component[1..n].
+int kosarajuComponents(Graph G, int *component) {
+    int n = getOrder(G);
+    int count = 0;
+    int *order = (int *) malloc((n > 0 ? n : 1)*sizeof(int));
+    int *finished = (int *) malloc((n > 0 ? n : 1)*sizeof(int));
+    for (int i = 0; i < n; i += 1) {
+        order[i] = i + 1;
+    }
+    DFSOrderArray(G, order, finished);
+    DFSReverseArray(G, finished, order);
+
+    // Each DFS tree of the reversed pass is one SCC; order lists the last tree first.
+    for (int i = n - 1; i >= 0; i -= 1) {
+        if (getParent(G, order[i]) == NIL) {
+            count += 1;
+        }
+    }
+    int current = count + 1;
+    for (int i = 0; i < n; i += 1) {
+        if (getParent(G, order[i]) == NIL) {
+            current -= 1;
+        }
+        component[order[i]] = current;
+    }
+    free(order);
+    free(finished);
+    return count;
+}
+
+// Finds the SCC's of G with the given method, writing component ids 1, 2, ... in
+// topological order into component[1..n] and returning the number of SCC's.
+int findComponents(Graph G, int *component, int method, int threads) {
+    if (method == SCC_PEARCE) {
+        return SCC(G, component);
+    } else if (method == SCC_PARALLEL) {
+        return parallelSCC(G, component, threads);
+    }
+    return kosarajuComponents(G, component);
+}
+
+// Like findComponents(), but first trims the trivial SCC's of G and only runs the
+// given method on the subgraph induced by the remaining core vertices. Sets
+// *visited and *max_depth to the getVisited() and getMaxDepth() of that core pass.
+int trimmedComponents(Graph G, int *component, int method, int threads, int *visited, int *max_depth) {
+    int n = getOrder(G);
+    int sources;
+    int trimmed = trimGraph(G, component, &sources);
+
+    int *vertex_of = (int *) malloc((n + 1)*sizeof(int));
+    Graph core = inducedSubgraph(G, component, vertex_of);
+    int *core_component = (int *) malloc((getOrder(core) + 1)*sizeof(int));
+    int core_count = findComponents(core, core_component, method, threads);
+    int count = trimmed + core_count;
+    *visited = getVisited(core);
+    *max_depth = getMaxDepth(core);
+
+    // Sink ids n, n-1, ... move up against the core, then the core ids are placed
+    // after the sources.
+    for (int v = 1; v < n + 1; v += 1) {
+        if (component[v] > sources) {
+            component[v] = component[v] - n + count;
+        }
+    }
+    for (int i = 1; i < getOrder(core) + 1; i += 1) {
+        component[vertex_of[i]] = sources + core_component[i];
+    }
+
+    freeGraph(&core);
+    free(vertex_of);
+    free(core_component);
+    return count;
+}
 
 int main(int argc, char * argv[]) {
     
-    FILE *in_file, *out_file;
+    FILE *out_file;
+    char *in_name = NULL;
+    char *out_name = NULL;
+    int method = SCC_KOSARAJU;
+    int threads = 0;
+    bool binary_input = false;
+    bool trim = false;
+    int output = OUTPUT_COMPONENTS;
+    bool print_adjacency = true;
+    Stats S = {0};
+    S.start = now();
 
     int vertices;
-    int end_1;
-    int end_2;
     int scc_counter = 0;
     int vertex;
 
-    // Checks command line for correct number of arguments.
-    if (argc != 3) {
-        fprintf(stderr, "Usage: %s <input file> <output file>\n", argv[0]);
-        exit(EXIT_FAILURE);
+    // Parses the command line options, followed by the input and output file names.
+    for (int i = 1; i < argc; i += 1) {
+        if (strcmp(argv[i], "--scc=kosaraju") == 0) {
+            method = SCC_KOSARAJU;
+        } else if (strcmp(argv[i], "--scc=pearce") == 0) {
+            method = SCC_PEARCE;
+        } else if (strcmp(argv[i], "--scc=parallel") == 0) {
+            method = SCC_PARALLEL;
+        } else if (strncmp(argv[i], "--threads=", 10) == 0) {
+            threads = atoi(argv[i] + 10);
+        } else if (strcmp(argv[i], "--output=components") == 0) {
+            output = OUTPUT_COMPONENTS;
+        } else if (strcmp(argv[i], "--output=condensation") == 0) {
+            output = OUTPUT_CONDENSATION;
+        } else if (strcmp(argv[i], "--output=map") == 0) {
+            output = OUTPUT_MAP;
+        } else if (strcmp(argv[i], "--no-adjacency") == 0) {
+            print_adjacency = false;
+        } else if (strcmp(argv[i], "--trim") == 0) {
+            trim = true;
+        } else if (strcmp(argv[i], "--format=text") == 0) {
+            binary_input = false;
+        } else if (strcmp(argv[i], "--format=binary") == 0) {
+            binary_input = true;
+        } else if (strcmp(argv[i], "--stats") == 0) {
+            S.enabled = true;
+        } else if (argv[i][0] == '-' && argv[i][1] == '-') {
+            fprintf(stderr, "Unknown option %s\n", argv[i]);
+            exit(EXIT_FAILURE);
+        } else if (in_name == NULL) {
+            in_name = argv[i];
+        } else if (out_name == NULL) {
+            out_name = argv[i];
+        } else {
+            in_name = NULL;
+            break;
+        }
     }
 
-    // Open the infile for reading.
-    // If the file cannot be opened, produce an error statement and end the program.
-    in_file = fopen(argv[1], "r");
-    if (in_file == NULL) {
-        fprintf(stderr, "Unable to open file %s for reading\n", argv[1]);
+    // Checks command line for correct number of arguments.
+    if (in_name == NULL || out_name == NULL) {
+        fprintf(stderr, "Usage: %s [--scc=kosaraju|pearce|parallel] [--threads=N] [--trim] [--output=components|condensation|map] [--no-adjacency] [--format=text|binary] [--stats] <input file> <output file>\n", argv[0]);
         exit(EXIT_FAILURE);
     }
 
     // Open the outfile for writing.
     // If the file cannot be opened, produce an error statement and end the program.
-    out_file = fopen(argv[2], "w");
-    if (in_file == NULL) {
-        fprintf(stderr, "Unable to open file %s for reading\n", argv[2]);
+    out_file = fopen(out_name, "w");
+    if (out_file == NULL) {
+        fprintf(stderr, "Unable to open file %s for writing\n", out_name);
         exit(EXIT_FAILURE);
     }
+    Writer W = newWriter(out_file);
 
-    // Scans in the number of vertices and creates a graph G.
-    fscanf(in_file, "%d\n", &vertices);
-    Graph G = newGraph(vertices);
+    // Reads the graph G from the infile, parsing the arcs and building the
+    // adjacency as separate phases for text input.
+    Graph G;
+    if (binary_input) {
+        beginPhase(&S, "load");
+        G = loadGraph(in_name);
+        endPhase(&S);
+    } else {
+        int *sources;
+        int *targets;
+        beginPhase(&S, "parse");
+        int arcs = readEdges(in_name, &vertices, &sources, &targets);
+        endPhase(&S);
+        beginPhase(&S, "build");
+        G = newGraphFromEdges(vertices, sources, targets, arcs);
+        free(sources);
+        free(targets);
+        endPhase(&S);
+    }
+    vertices = getOrder(G);
+    addCounter(&S, "vertices", vertices);
+    addCounter(&S, "arcs_loaded", getSize(G));
 
-    // Creates the initial stack of vertices from 1,2,...,n
-    List S = newList();
-    for (int i = 1; i < vertices + 1; i += 1) {
-        append(S, i);
+    // Creates the initial order of vertices 1,2,...,n, and a buffer for the finish order.
+    int *order = (int *) malloc((vertices > 0 ? vertices : 1)*sizeof(int));
+    int *finished = (int *) malloc((vertices > 0 ? vertices : 1)*sizeof(int));
+    for (int i = 0; i < vertices; i += 1) {
+        order[i] = i + 1;
     }
 
-    // Scans in all edges and adds them to the graph G.
-    do {
-        fscanf(in_file, "%d" "%d\n", &end_1, &end_2);
-        if (end_1 == 0 && end_2 == 0) {
-            break;
-        }
-        addArc(G, end_1, end_2);
-    } while (true);
+    if (print_adjacency) {
+        beginPhase(&S, "adjacency");
+        writeString(W, "Adjacency list representation of G:\n");
+        writeGraph(W, G);
+        writeChar(W, '\n');
+        endPhase(&S);
+    }
 
-    fprintf(out_file, "Adjacency list representation of G:\n");
-    printGraph(out_file, G);
-    fprintf(out_file, "\n");
+    // Finds the SCC's in one depth-first pass, with several threads, or after
+    // trimming, and prints them (and the component DAG) from the resulting
+    // component-id array.
+    if (method != SCC_KOSARAJU || trim || output != OUTPUT_COMPONENTS) {
+        int *component = (int *) malloc((vertices + 1)*sizeof(int));
+        int visited;
+        int max_depth;
+        beginPhase(&S, "scc");
+        if (trim) {
+            scc_counter = trimmedComponents(G, component, method, threads, &visited, &max_depth);
+        } else {
+            scc_counter = findComponents(G, component, method, threads);
+            visited = getVisited(G);
+            max_depth = getMaxDepth(G);
+        }
+        endPhase(&S);
+        addCounter(&S, "scc_visited", visited);
+        addCounter(&S, "scc_max_depth", max_depth);
+        addCounter(&S, "components", scc_counter);
+        beginPhase(&S, "output");
+        if (output == OUTPUT_MAP) {
+            printComponentMap(W, vertices, component);
+        } else {
+            printComponents(W, vertices, component, scc_counter);
+        }
+        if (output == OUTPUT_CONDENSATION) {
+            printCondensation(W, G, component, scc_counter);
+        }
+        flushWriter(W);
+        endPhase(&S);
+        free(component);
+        free(order);
+        free(finished);
+        freeGraph(&G);
+        freeWriter(&W);
+        fclose(out_file);
+        printStats(&S);
+        return 0;
+    }
 
-    // Runs DFS on G and the transpose of G.
-    DFS(G, S);
-    Graph trans = transpose(G);
-    DFS(trans, S);
+    // Runs DFS on G and then over the reversed arcs of G, which follows the arcs of the
+    // transpose without building it; the first pass only needs the finish order.
+    // After the second pass, order holds the vertices in decreasing finish time.
+    beginPhase(&S, "dfs1");
+    DFSOrderArray(G, order, finished);
+    endPhase(&S);
+    addCounter(&S, "dfs1_visited", getVisited(G));
+    addCounter(&S, "dfs1_max_depth", getMaxDepth(G));
+    beginPhase(&S, "dfs2");
+    DFSReverseArray(G, finished, order);
+    endPhase(&S);
+    addCounter(&S, "dfs2_visited", getVisited(G));
+    addCounter(&S, "dfs2_max_depth", getMaxDepth(G));
 
     // Finds the number of SCC's.
-    moveFront(S);
-    for (int i = 0; i < length(S); i += 1) {
-        vertex = get(S);
-        if (getParent(trans, vertex) == NIL) {
+    for (int i = 0; i < vertices; i += 1) {
+        if (getParent(G, order[i]) == NIL) {
             scc_counter += 1;
         }
-        moveNext(S);
     }
 
-    fprintf(out_file, "G contains %d strongly connected components:\n", scc_counter);
+    addCounter(&S, "components", scc_counter);
+    beginPhase(&S, "output");
+    writeString(W, "G contains ");
+    writeInt(W, scc_counter);
+    writeString(W, " strongly connected components:\n");
 
-    // Prints out the SCC's in topological sorted order to the outfile.
-    List scc = newList();
+    // Prints out the SCC's in topological sorted order to the outfile. Each DFS tree
+    // of the reversed pass is one SCC, stored in order from its root onwards, and the
+    // trees appear in order last tree first.
     scc_counter = 0;
-    moveBack(S);
-    for (int i = 0; i < length(S); i += 1) {
-        vertex = get(S);
-        prepend(scc, vertex);
-        if (getParent(trans, vertex) == NIL) {
+    int end = vertices;
+    for (int i = vertices - 1; i >= 0; i -= 1) {
+        vertex = order[i];
+        if (getParent(G, vertex) == NIL) {
             scc_counter += 1;
-            fprintf(out_file, "Component %d: ", scc_counter);
-            printList(out_file, scc);
-            fprintf(out_file, "\n");
-            clear(scc);
+            writeString(W, "Component ");
+            writeInt(W, scc_counter);
+            writeString(W, ": ");
+            for (int j = i; j < end; j += 1) {
+                writeInt(W, order[j]);
+                writeChar(W, ' ');
+            }
+            writeChar(W, '\n');
+            end = i;
         }
-        movePrev(S);
     }
+    flushWriter(W);
+    endPhase(&S);
 
     // Freeing of allocated memory.
     freeGraph(&G);
-    freeGraph(&trans);
-    freeList(&S);
-    freeList(&scc);
+    free(order);
+    free(finished);
     
-    // Closing of files.
-    fclose(in_file);
+    // Flushing and closing of the outfile.
+    freeWriter(&W);
     fclose(out_file);
+    printStats(&S);
 
     return 0;
 }
@@ -1,344 +1,3662 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdatomic.h>
 #include "Graph.h"
 #include "List.h"
+#include "Writer.h"
 
 // structs --------------------------------------------------------------------
 
+// Private VertexState type: the DFS state of one vertex, packed together so a
+// visit touches one cache line. The state is current only while stamp equals the
+// epoch of the Graph; a vertex with an older stamp reads as WHITE with parent NIL
+// and no times, so a new traversal starts by bumping the epoch instead of
+// resetting every vertex. The color is not stored: a current vertex is GRAY while
+// finish == UNDEF and BLACK once it is set.
+typedef struct VertexState {
+    int parent;
+    int discover;
+    int finish;
+    int stamp;
+} VertexState;
+
+// Private RemovalSlot type: one entry of the open-addressing hash table that counts
+// the staged removals of the arc tail -> head. Empty slots have tail 0.
+typedef struct RemovalSlot {
+    int tail;
+    int head;
+    int count;
+} RemovalSlot;
+
 // Private GraphObj type.
+// Adjacency is stored in compressed sparse row (CSR) form: the neighbors of
+// vertex u are adj[adj_offsets[u]] .. adj[adj_offsets[u + 1] - 1], in sorted order.
+// Arcs added through addArc()/addEdge() are staged in the pending arrays, and arcs
+// removed through removeArc()/removeEdge() in the removed arrays; both are merged
+// into the CSR arrays the next time the adjacency is read. removed_table counts
+// the staged removals of each arc, so a removal can be checked against the copies
+// of the arc still left without merging first.
+// A Graph returned by loadGraph() points adj_offsets and adj into the read-only
+// file mapping; mapping is NULL when the CSR arrays are heap-allocated.
+// The reverse index radj_offsets/radj holds the in-neighbors of every vertex in the
+// same sorted CSR form. It is built the first time it is needed and dropped along
+// with the CSR arrays whenever they change.
 typedef struct GraphObj {
-    List *list_array;
-    int *color_array;
-    int *parent_array;
-    int *disc_array;
-    int *finish_array;
+    int *adj_offsets;
+    int *adj;
+    int *radj_offsets;
+    int *radj;
+    int *pending_src;
+    int *pending_dst;
+    int pending_count;
+    int pending_capacity;
+    int *removed_src;
+    int *removed_dst;
+    int removed_count;
+    int removed_capacity;
+    RemovalSlot *removed_table;
+    int removed_slots;
+    VertexState *state;
+    int epoch;
+    void *mapping;
+    size_t mapping_length;
     int order;
     int size;
+    int visited;
+    int max_depth;
 } GraphObj;
 
+// Private GraphFileHeader type: the header of the binary graph format written by
+// saveGraph(). It is followed by the order + 2 CSR offsets and the arcs neighbor
+// labels, all 32-bit ints; checksum covers both arrays.
+typedef struct GraphFileHeader {
+    char magic[8];
+    uint32_t version;
+    int32_t order;
+    int64_t arcs;
+    int64_t size;
+    uint64_t checksum;
+} GraphFileHeader;
+
+#define GRAPH_FILE_MAGIC "DFSSCCG1"
+#define GRAPH_FILE_VERSION 1
+
+// Private DFSFrame type: one entry of the explicit DFS stack, holding the vertex
+// being visited and the position of the next arc to examine in adj.
+typedef struct DFSFrame {
+    int vertex;
+    int next;
+} DFSFrame;
+
+// Private SCCFrame type: one entry of the explicit stack used by SCC(), which
+// additionally remembers whether the vertex is still a candidate component root.
+typedef struct SCCFrame {
+    int vertex;
+    int next;
+    bool root;
+} SCCFrame;
+
+#define TRIM_ROUNDS 3
+#define BFS_CHUNK 256
+
+// Private ParallelSCC type: state shared by the worker threads of parallelSCC().
+// component[v] is 0 while v is unassigned; reach[v] has bit 1 set once v is
+// reached forward from the pivot and bit 2 once it is reached backward.
+typedef struct ParallelSCC {
+    Graph G;
+    int *component;
+    atomic_uchar *reach;
+    int *frontier;
+    int *next_frontier;
+    int frontier_size;
+    atomic_int frontier_pos;
+    atomic_int next_size;
+    atomic_int next_label;
+    atomic_int trimmed;
+    int *best_vertex;
+    long long *best_score;
+    int pivot;
+    int pivot_label;
+    int threads;
+    pthread_barrier_t barrier;
+} ParallelSCC;
+
+// Private SCCWorker type: the argument passed to each parallelSCC() thread.
+typedef struct SCCWorker {
+    ParallelSCC *P;
+    int id;
+} SCCWorker;
+
+#define REVERSE_GRAIN (1 << 18)
+
+// Private ReverseFill type: state shared by the worker threads of reverseArcs().
+// Thread t reads the out-arcs of the sources first[t] .. first[t + 1] - 1 (ranges
+// with about the same number of arcs) and counts their heads in its own histogram
+// counts[t*(n + 2) .. (t + 1)*(n + 2) - 1], which later holds where in each reversed
+// row thread t starts writing. totals[t] is the number of in-arcs of the vertices
+// whose offsets thread t computes.
+typedef struct ReverseFill {
+    Graph G;
+    int *offsets;
+    int *adj;
+    int *first;
+    int *counts;
+    long long *totals;
+    int threads;
+    pthread_barrier_t barrier;
+} ReverseFill;
+
+// Private ReverseWorker type: the argument passed to each reverseArcs() thread.
+typedef struct ReverseWorker {
+    ReverseFill *R;
+    int id;
+} ReverseWorker;
+
+// Private GraphViewObj type: a read-only view of the CSR adjacency of a Graph
+// and of its reverse index. Nothing reachable from it is written after
+// newGraphView() returns, so any number of threads can read it at once.
+typedef struct GraphViewObj {
+    const int *adj_offsets;
+    const int *adj;
+    const int *radj_offsets;
+    const int *radj;
+    int order;
+    int size;
+} GraphViewObj;
+
+// Private ViewSearchObj type: the private state of one thread's searches over a
+// GraphView. A vertex counts as visited by the current search while its stamp
+// equals epoch, so each search starts by bumping epoch rather than clearing
+// anything. The batch search arrays are allocated by
+// the first viewReachBatch(): bit i of seen[v] is set once source i of the last
+// batch reached v, and the reached_count vertices with seen[v] != 0 are listed in
+// reached[], so the next batch can clear them. visit[] and next[] hold the bits
+// that reached each vertex of the current and next BFS level, listed in frontier[]
+// and next_frontier[].
+typedef struct ViewSearchObj {
+    GraphView V;
+    int *stamp;
+    int epoch;
+    int *order;
+    DFSFrame *stack;
+    uint64_t *seen;
+    uint64_t *visit;
+    uint64_t *next;
+    int *frontier;
+    int *next_frontier;
+    int *reached;
+    int reached_count;
+} ViewSearchObj;
+
+#define REACH_LABELS 3
+#define CLOSURE_LIMIT 4096
+
+// Private ReachIndexObj type: answers reachability queries on a Graph through its
+// condensation C, whose components 1..count are numbered in topological order.
+// level[c] is the length of the longest path in C ending at c. For each of the
+// REACH_LABELS labellings l, rank[l*(count + 1) + c] is the postorder rank of c in
+// a randomized DFS of C and low[...] the smallest rank among the components c
+// reaches, so d is reachable from c only if [low(d), rank(d)] lies inside
+// [low(c), rank(c)]. If count <= CLOSURE_LIMIT, closure holds the full transitive
+// closure instead, words 64-bit words per component. stamp, epoch and stack are
+// the scratch state of the pruned search behind queries the labels cannot settle.
+typedef struct ReachIndexObj {
+    Graph C;
+    int *component;
+    int *level;
+    int *rank;
+    int *low;
+    uint64_t *closure;
+    int words;
+    int *stamp;
+    int epoch;
+    int *stack;
+    int order;
+    int count;
+} ReachIndexObj;
+
+// Private ArcBuffer type: a growable array of count arcs of G, stored as
+// (tail, head) pairs in arcs[0 .. 2*count - 1]. owned is false while arcs still
+// points into the shared pool filled by newDynamicSCC().
+typedef struct ArcBuffer {
+    int *arcs;
+    int count;
+    int capacity;
+    bool owned;
+} ArcBuffer;
+
+// Private DynamicSCCObj type.
+// Keeps the SCC's of G, and a topological order of them, up to date as arcs are
+// inserted and removed. Every component has a label in 1..labels; a component
+// merged into another points at it through leader, so the component of vertex v
+// is the root of label[v] in this union-find forest. The members of a live
+// component c form the circular list member[c], next_member[member[c]], ...
+// out[c] and in[c] hold the arcs of G leaving and entering c; arcs that became
+// internal to c through a merge may remain in them and are skipped.
+// position[c] is the place of live component c in the topological order and at[p]
+// the component at place p, or 0 once the place is left empty by a merge.
+typedef struct DynamicSCCObj {
+    Graph G;
+    int *label;
+    int *next_member;
+    int *local;
+    int *pool;
+    ArcBuffer *out;
+    ArcBuffer *in;
+    int *leader;
+    int *member;
+    int *position;
+    int *forward_mark;
+    int *backward_mark;
+    int stamp;
+    int *at;
+    int *forward;
+    int *backward;
+    int *places_of;
+    int *sequence;
+    int places;
+    int labels;
+    int capacity;
+    int count;
+} DynamicSCCObj;
+
 // Private Helper Function -----------------------------------------------------------
 
-// Helper function declaration.
-void visit(Graph G, List S, int u, int *time);
+// Helper function declarations.
+int visit(Graph G, const int *offsets, const int *adj, int *finish_order, int *top, DFSFrame *stack, int u, int *time);
+int visitOrder(const int *offsets, const int *adj, int *finish_order, int *top, DFSFrame *stack, bool *visited, int u);
+int depthFirst(Graph G, const int *order, int count, int *finish_order, bool record_state, bool reverse);
+void depthFirstList(Graph G, List S, bool record_state, bool reverse);
+void beginTraversal(Graph G);
+void stageArc(Graph G, int u, int v);
+void stageRemoval(Graph G, int u, int v);
+RemovalSlot *findRemoval(const RemovalSlot *table, int slots, int u, int v);
+int countArc(Graph G, int u, int v);
+void sortArcs(int n, const int *src, const int *dst, int m, int *offsets, int *adj);
+void buildAdjacency(Graph G);
+void *reverseWorker(void *arg);
+void reverseArcs(Graph G, int *offsets, int *adj);
+void buildReverse(Graph G);
+void releaseAdjacency(Graph G);
+void checkSearch(ViewSearch S, int u, const char *caller);
+void nextEpoch(ViewSearch S);
+void labelComponents(ReachIndex R, int *rank, int *low, uint64_t seed);
+bool mayReach(ReachIndex R, int c, int d);
+bool searchReach(ReachIndex R, int c, int d);
+int pearceComponents(Graph G, int *rindex, const int *exclude);
+uint64_t checksumWords(const int *words, size_t count, uint64_t state);
+bool hasLiveNeighbor(const int *offsets, const int *adj, int v, const int *component);
+void reachFromPivot(ParallelSCC *P, const int *offsets, const int *adj, unsigned char bit, int *buffer);
+void *sccWorker(void *arg);
+void numberTopologically(Graph G, int *component, int count);
+int findLeader(DynamicSCC D, int c);
+void pushArc(ArcBuffer *B, int tail, int head);
+void dropArc(ArcBuffer *B, int tail, int head);
+void releaseArcs(ArcBuffer *B);
+void nextStamp(DynamicSCC D);
+int newLabel(DynamicSCC D);
+int searchComponents(DynamicSCC D, int c, bool forward, int low, int high, int *found);
+void mergeComponents(DynamicSCC D, int rep, const int *members, int count);
+int splitComponent(DynamicSCC D, int c, int *pieces);
+int compareInts(const void *a, const void *b);
 
-// Helper function for DFS().
-void visit(Graph G, List S, int u, int *time) {
+// Visits every vertex reachable from u that is still WHITE in the current epoch, using the explicit
+// frame stack instead of recursion so that deep graphs cannot overflow the C stack.
+// Discover/finish times and the order vertices are pushed onto the finish_order
+// stack (filled downwards from finish_order[*top - 1]) match a recursive visit.
+// The arcs followed are the CSR rows offsets/adj: G's own or its reverse index.
+// Returns the largest number of frames on the stack at once.
+int visit(Graph G, const int *offsets, const int *adj, int *finish_order, int *top, DFSFrame *stack, int u, int *time) {
+    VertexState *state = G->state;
+    int epoch = G->epoch;
+    int depth = 0;
+    int max_depth = 0;
     int adjacent_vert;
+
     *time += 1;
-    G->disc_array[u] = *time;
-    G->color_array[u] = GRAY;
-    moveFront(G->list_array[u]);
-    for (int i = 0; i < length(G->list_array[u]); i += 1) {
-        adjacent_vert = get(G->list_array[u]);
-        if (G->color_array[adjacent_vert] == WHITE) {
-            G->parent_array[adjacent_vert] = u;
-            visit(G, S, adjacent_vert, time);
-        }
-        moveNext(G->list_array[u]);
-    }
-    G->color_array[u] = BLACK;
-    *time += 1;
-    G->finish_array[u] = *time;
-    prepend(S, u);
-    return;
-}
+    state[u].parent = NIL;
+    state[u].discover = *time;
+    state[u].finish = UNDEF;
+    state[u].stamp = epoch;
+    stack[0].vertex = u;
+    stack[0].next = offsets[u];
 
-// Constructors-Destructors ---------------------------------------------------
+    while (depth >= 0) {
+        DFSFrame *frame = &stack[depth];
+        int end = offsets[frame->vertex + 1];
 
-// Graph constructor.
-Graph newGraph(int n) {
-    Graph G = malloc(sizeof(GraphObj));
-    G->list_array = (List *) malloc((n + 1)*sizeof(List));
-    for (int i = 1; i < n + 1; i += 1) {
-        G->list_array[i] = newList();
+        // Advances to the next undiscovered neighbor of the current vertex.
+        while (frame->next < end && state[adj[frame->next]].stamp == epoch) {
+            frame->next += 1;
+        }
+
+        if (frame->next < end) {
+            adjacent_vert = adj[frame->next];
+            frame->next += 1;
+            state[adjacent_vert].parent = frame->vertex;
+            *time += 1;
+            state[adjacent_vert].discover = *time;
+            state[adjacent_vert].finish = UNDEF;
+            state[adjacent_vert].stamp = epoch;
+            depth += 1;
+            if (depth > max_depth) {
+                max_depth = depth;
+            }
+            stack[depth].vertex = adjacent_vert;
+            stack[depth].next = offsets[adjacent_vert];
+        } else {
+            *time += 1;
+            state[frame->vertex].finish = *time;
+            *top -= 1;
+            finish_order[*top] = frame->vertex;
+            depth -= 1;
+        }
     }
+    return max_depth + 1;
+}
 
-    G->color_array = (int *) calloc(n + 1, sizeof(int));
-    G->parent_array = (int *) calloc(n + 1, sizeof(int));
-    for (int i = 1; i < n + 1; i += 1) {
-        G->parent_array[i] = NIL;
+// Same traversal as visit(), but only records which vertices have been seen in
+// visited and pushes finished vertices onto finish_order; no DFS state is written.
+int visitOrder(const int *offsets, const int *adj, int *finish_order, int *top, DFSFrame *stack, bool *visited, int u) {
+    int depth = 0;
+    int max_depth = 0;
+
+    visited[u] = true;
+    stack[0].vertex = u;
+    stack[0].next = offsets[u];
+
+    while (depth >= 0) {
+        DFSFrame *frame = &stack[depth];
+        int end = offsets[frame->vertex + 1];
+        while (frame->next < end && visited[adj[frame->next]]) {
+            frame->next += 1;
+        }
+
+        if (frame->next < end) {
+            int adjacent_vert = adj[frame->next];
+            frame->next += 1;
+            visited[adjacent_vert] = true;
+            depth += 1;
+            if (depth > max_depth) {
+                max_depth = depth;
+            }
+            stack[depth].vertex = adjacent_vert;
+            stack[depth].next = offsets[adjacent_vert];
+        } else {
+            *top -= 1;
+            finish_order[*top] = frame->vertex;
+            depth -= 1;
+        }
     }
+    return max_depth + 1;
+}
 
-    G->disc_array = (int *) calloc(n + 1, sizeof(int));
-    for (int i = 1; i < n + 1; i += 1) {
-        G->disc_array[i] = UNDEF;
+// Runs DFS on G, starting new trees at the vertices order[0 .. count - 1] in turn,
+// and writes the visited vertices in decreasing finish time into the last entries
+// of finish_order. Follows in-arcs through the reverse index instead of out-arcs
+// if reverse is true. Records parents and discover/finish times if record_state is
+// true, and the number of vertices visited and the deepest DFS stack in any case.
+// Returns the number of vertices written (n when order is a permutation).
+int depthFirst(Graph G, const int *order, int count, int *finish_order, bool record_state, bool reverse) {
+    int n = G->order;
+    int top = n;
+    int time = 0;
+    int max_depth = 0;
+    buildAdjacency(G);
+    if (reverse) {
+        buildReverse(G);
+    }
+    const int *offsets = reverse ? G->radj_offsets : G->adj_offsets;
+    const int *adj = reverse ? G->radj : G->adj;
+    DFSFrame *stack = (DFSFrame *) malloc((n + 1)*sizeof(DFSFrame));
+    bool *visited = record_state ? NULL : (bool *) calloc(n + 1, sizeof(bool));
+    if (stack == NULL || (!record_state && visited == NULL)) {
+        fprintf(stderr, "Graph Error: out of memory in DFS()\n");
+        exit(EXIT_FAILURE);
     }
 
-    G->finish_array = (int *) calloc(n + 1, sizeof(int));
-    for (int i = 1; i < n + 1; i += 1) {
-        G->finish_array[i] = UNDEF;
+    if (record_state) {
+        // A new epoch makes every vertex undiscovered (WHITE) with parent NIL.
+        beginTraversal(G);
+        for (int i = 0; i < count; i += 1) {
+            if (G->state[order[i]].stamp != G->epoch) {
+                int depth = visit(G, offsets, adj, finish_order, &top, stack, order[i], &time);
+                if (depth > max_depth) {
+                    max_depth = depth;
+                }
+            }
+        }
+    } else {
+        for (int i = 0; i < count; i += 1) {
+            if (!visited[order[i]]) {
+                int depth = visitOrder(offsets, adj, finish_order, &top, stack, visited, order[i]);
+                if (depth > max_depth) {
+                    max_depth = depth;
+                }
+            }
+        }
     }
 
-    G->order = n;
-    G->size = 0;
-    return G;
+    free(stack);
+    free(visited);
+    G->visited = n - top;
+    G->max_depth = max_depth;
+    return n - top;
 }
 
-// Graph Destructor.
-void freeGraph(Graph* pG) {
-    if (pG != NULL && *pG != NULL && (*pG)->list_array && (*pG)->color_array && (*pG)->parent_array && (*pG)->disc_array && (*pG)->finish_array) { 
-        for (int i = 1; i < getOrder(*pG) + 1; i += 1) {
-            freeList(&(*pG)->list_array[i]);
-        }
-        free((*pG)->list_array);
-        free((*pG)->color_array);
-        free((*pG)->parent_array);
-        free((*pG)->disc_array);
-        free((*pG)->finish_array);
-        free(*pG);
-        *pG = NULL;
+// Starts a new epoch of the DFS state of G, after which every vertex reads as
+// undiscovered. Only when the counter would overflow are all stamps cleared.
+void beginTraversal(Graph G) {
+    if (G->epoch == INT_MAX) {
+        for (int i = 0; i < G->order + 1; i += 1) {
+            G->state[i].stamp = 0;
+        }
+        G->epoch = 0;
     }
+    G->epoch += 1;
     return;
 }
 
-// Accessor functions -----------------------------------------------------------
-
-// Returns the order of the Graph.
-int getOrder(Graph G) {
-    if (G == NULL) {
-        fprintf(stderr, "Graph Error: calling getOrder() on NULL Graph reference\n");
+// Runs depthFirst() with the vertices of S as the start order, then replaces the
+// contents of S with the vertices in decreasing finish time.
+void depthFirstList(Graph G, List S, bool record_state, bool reverse) {
+    int n = G->order;
+    int *order = (int *) malloc((n > 0 ? n : 1)*sizeof(int));
+    int *finish_order = (int *) malloc((n > 0 ? n : 1)*sizeof(int));
+    if (order == NULL || finish_order == NULL) {
+        fprintf(stderr, "Graph Error: out of memory in DFS()\n");
         exit(EXIT_FAILURE);
     }
-    return G->order;
+    int count = 0;
+    int v;
+    ListIterator I;
+    beginList(S, &I);
+    while (nextElement(&I, &v)) {
+        if (v < 1 || v > n) {
+            fprintf(stderr, "Graph Error: calling DFS() with invalid stack\n");
+            exit(EXIT_FAILURE);
+        }
+        order[count++] = v;
+    }
+
+    int finished = depthFirst(G, order, count, finish_order, record_state, reverse);
+    clear(S);
+    for (int i = n - finished; i < n; i += 1) {
+        append(S, finish_order[i]);
+    }
+
+    free(order);
+    free(finish_order);
+    return;
 }
 
-// Returns the size of the Graph.
-int getSize(Graph G) {
-    if (G == NULL) {
-        fprintf(stderr, "Graph Error: calling getSize() on NULL Graph reference\n");
-        exit(EXIT_FAILURE);
+// Appends the arc (u, v) to the pending arc arrays, growing them as needed.
+void stageArc(Graph G, int u, int v) {
+    if (G->pending_count == G->pending_capacity) {
+        G->pending_capacity = (G->pending_capacity == 0) ? 16 : 2*G->pending_capacity;
+        G->pending_src = (int *) realloc(G->pending_src, G->pending_capacity*sizeof(int));
+        G->pending_dst = (int *) realloc(G->pending_dst, G->pending_capacity*sizeof(int));
+        if (G->pending_src == NULL || G->pending_dst == NULL) {
+            fprintf(stderr, "Graph Error: out of memory while adding arcs\n");
+            exit(EXIT_FAILURE);
+        }
     }
-    return G->size;
+    G->pending_src[G->pending_count] = u;
+    G->pending_dst[G->pending_count] = v;
+    G->pending_count += 1;
+    return;
 }
 
-// Returns the parent of vertex u in the DFS forest created by DFS()
-// Returns NIL if a DFS hasn't ocurred yet (a parent may be NIL even if DFS has occured).
-// Pre: 1 <= u <= getOrder(G) (the order of the graph/number of vertices).
-int getParent(Graph G, int u) {
-    if (G == NULL) {
-        fprintf(stderr, "Graph Error: calling getParent() on NULL Graph reference\n");
-        exit(EXIT_FAILURE);
+// Appends the arc (u, v) to the removed arc arrays, growing them as needed.
+// Pre: the CSR arrays of G contain the arc u -> v
+void stageRemoval(Graph G, int u, int v) {
+    if (G->removed_count == G->removed_capacity) {
+        G->removed_capacity = (G->removed_capacity == 0) ? 16 : 2*G->removed_capacity;
+        G->removed_src = (int *) realloc(G->removed_src, G->removed_capacity*sizeof(int));
+        G->removed_dst = (int *) realloc(G->removed_dst, G->removed_capacity*sizeof(int));
+        if (G->removed_src == NULL || G->removed_dst == NULL) {
+            fprintf(stderr, "Graph Error: out of memory while removing arcs\n");
+            exit(EXIT_FAILURE);
+        }
     }
-    if (u < 1 || u > getOrder(G)) {
-        fprintf(stderr, "Graph Error: calling getParent() with invalid vertex/vertices\n");
-        exit(EXIT_FAILURE);
+    G->removed_src[G->removed_count] = u;
+    G->removed_dst[G->removed_count] = v;
+    G->removed_count += 1;
+
+    // Keeps the table at most half full, rehashing into twice the slots.
+    if (2*G->removed_count > G->removed_slots) {
+        int slots = (G->removed_slots == 0) ? 32 : 2*G->removed_slots;
+        RemovalSlot *table = (RemovalSlot *) calloc(slots, sizeof(RemovalSlot));
+        if (table == NULL) {
+            fprintf(stderr, "Graph Error: out of memory while removing arcs\n");
+            exit(EXIT_FAILURE);
+        }
+        for (int i = 0; i < G->removed_slots; i += 1) {
+            if (G->removed_table[i].tail != 0) {
+                RemovalSlot *slot = G->removed_table + i;
+                *findRemoval(table, slots, slot->tail, slot->head) = *slot;
+            }
+        }
+        free(G->removed_table);
+        G->removed_table = table;
+        G->removed_slots = slots;
     }
-    return G->parent_array[u];
+    RemovalSlot *slot = findRemoval(G->removed_table, G->removed_slots, u, v);
+    slot->tail = u;
+    slot->head = v;
+    slot->count += 1;
+    return;
 }
 
-// Returns the discover time of a vertex after DFS().
-// If DFS() hasn't been called, returns UNDEF.
-// Pre: 1 <= u <= getOrder(G) (the order of the graph/number of vertices).
-int getDiscover(Graph G, int u) {
-    if (G == NULL) {
-        fprintf(stderr, "Graph Error: calling getDiscover() on NULL Graph reference\n");
-        exit(EXIT_FAILURE);
-    }
-    if (u < 1 || u > getOrder(G)) {
-        fprintf(stderr, "Graph Error: calling getDiscover() with invalid vertex/vertices\n");
-        exit(EXIT_FAILURE);
+// Returns the slot of the arc u -> v in the removal table of the given size (a
+// power of two), or the empty slot where it belongs if it has none.
+RemovalSlot *findRemoval(const RemovalSlot *table, int slots, int u, int v) {
+    uint64_t key = ((uint64_t) (uint32_t) u << 32) | (uint32_t) v;
+    size_t i = (size_t) ((key*0x9E3779B97F4A7C15ULL) >> 32) & (slots - 1);
+    while (table[i].tail != 0 && (table[i].tail != u || table[i].head != v)) {
+        i = (i + 1) & (slots - 1);
     }
-    return G->disc_array[u];
+    return (RemovalSlot *) table + i;
 }
 
-// Returns the finish time of a vertex after DFS().
-// If DFS() hasn't been called, returns UNDEF.
-// Pre: 1 <= u <= getOrder(G) (the order of the graph/number of vertices).
-int getFinish(Graph G, int u) {
-    if (G == NULL) {
-        fprintf(stderr, "Graph Error: calling getFinish() on NULL Graph reference\n");
-        exit(EXIT_FAILURE);
+// Returns how many copies of the arc u -> v G holds that are not already staged
+// for removal: the copies found by binary search in the sorted row of u, less the
+// staged removals of u -> v counted in the removal table. Arcs still pending are
+// merged in first.
+int countArc(Graph G, int u, int v) {
+    if (G->pending_count > 0) {
+        buildAdjacency(G);
     }
-    if (u < 1 || u > getOrder(G)) {
-        fprintf(stderr, "Graph Error: calling getFinish() with invalid vertex/vertices\n");
-        exit(EXIT_FAILURE);
+    int low = G->adj_offsets[u];
+    int high = G->adj_offsets[u + 1];
+    while (low < high) {
+        int mid = low + (high - low)/2;
+        if (G->adj[mid] < v) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
     }
-    return G->finish_array[u];
+    int copies = 0;
+    while (low < G->adj_offsets[u + 1] && G->adj[low] == v) {
+        copies += 1;
+        low += 1;
+    }
+    if (copies > 0 && G->removed_count > 0) {
+        copies -= findRemoval(G->removed_table, G->removed_slots, u, v)->count;
+    }
+    return copies;
 }
 
-// Manipulation procedures ----------------------------------------------------
-
-// Adds an undirected edge between vertex u and v.
-// The vertex labels for each edge are maintained in sorted order.
-// Pre: 1 <= u <= getOrder(G)
-// Pre: 1 <= v <= getOrder(G)
-void addEdge(Graph G, int u, int v) {
-    if (G == NULL) {
-        fprintf(stderr, "Graph Error: calling addEdge() on NULL Graph reference\n");
+// Builds sorted CSR rows for the m arcs (src[i], dst[i]) of a graph of order n
+// in O(n + m) time. offsets must have room for n + 2 entries and adj for m entries.
+// The arcs are first bucketed by target, then scattered by source while the
+// targets are visited in increasing order, so every row comes out sorted.
+void sortArcs(int n, const int *src, const int *dst, int m, int *offsets, int *adj) {
+    int *by_target = (int *) malloc((m > 0 ? m : 1)*sizeof(int));
+    int *target_offsets = (int *) calloc(n + 2, sizeof(int));
+    int *fill = (int *) malloc((n + 2)*sizeof(int));
+    if (by_target == NULL || target_offsets == NULL || fill == NULL) {
+        fprintf(stderr, "Graph Error: out of memory while building adjacency\n");
         exit(EXIT_FAILURE);
     }
-    if (u < 1 || u > getOrder(G) || v < 1 || v > getOrder(G)) {
-        fprintf(stderr, "Graph Error: calling addEdge() with invalid vertex/vertices\n");
-        exit(EXIT_FAILURE);
+
+    // Counting sort by target: by_target[target_offsets[t] .. target_offsets[t + 1] - 1]
+    // holds the sources of the arcs into t.
+    for (int i = 0; i < m; i += 1) {
+        target_offsets[dst[i] + 1] += 1;
+    }
+    for (int t = 1; t < n + 1; t += 1) {
+        target_offsets[t + 1] += target_offsets[t];
+    }
+    for (int t = 0; t < n + 2; t += 1) {
+        fill[t] = target_offsets[t];
+    }
+    for (int i = 0; i < m; i += 1) {
+        by_target[fill[dst[i]]] = src[i];
+        fill[dst[i]] += 1;
     }
 
-    if (length(G->list_array[u]) == 0) {
-        append(G->list_array[u], v);
-    } else {
-        int j;
-        moveFront(G->list_array[u]);
-            while (index(G->list_array[u]) != -1) {
-                j = get(G->list_array[u]);
-                if (v < j) {
-                    insertBefore(G->list_array[u], v);
-                    break;
-                }
-                moveNext(G->list_array[u]);
-            }
-            if (index(G->list_array[u]) == -1) {
-                append(G->list_array[u], v);
-            }
+    // Counting sort by source, stable with respect to the target order above.
+    for (int u = 0; u < n + 2; u += 1) {
+        offsets[u] = 0;
     }
-    
-    if (length(G->list_array[v]) == 0) {
-        append(G->list_array[v], u);
-    } else {
-        int j;
-        moveFront(G->list_array[v]);
-            while (index(G->list_array[v]) != -1) {
-                j = get(G->list_array[v]);
-                if (u < j) {
-                    insertBefore(G->list_array[v], u);
-                    break;
-                }
-                moveNext(G->list_array[v]);
-            }
-            if (index(G->list_array[v]) == -1) {
-                append(G->list_array[v], u);
-            }
+    for (int i = 0; i < m; i += 1) {
+        offsets[src[i] + 1] += 1;
     }
-    G->size += 1;
+    for (int u = 1; u < n + 1; u += 1) {
+        offsets[u + 1] += offsets[u];
+    }
+    for (int u = 0; u < n + 2; u += 1) {
+        fill[u] = offsets[u];
+    }
+    for (int t = 1; t < n + 1; t += 1) {
+        for (int i = target_offsets[t]; i < target_offsets[t + 1]; i += 1) {
+            adj[fill[by_target[i]]] = t;
+            fill[by_target[i]] += 1;
+        }
+    }
+
+    free(by_target);
+    free(target_offsets);
+    free(fill);
     return;
 }
 
-// Adds a directed edge from u to v.
-// The vertex labels for each edge are maintained in sorted order.
-// Pre: 1 <= u <= getOrder(G)
-// Pre: 1 <= v <= getOrder(G)
-void addArc(Graph G, int u, int v) {
-    if (G == NULL) {
-        fprintf(stderr, "Graph Error: calling addArc() on NULL Graph reference\n");
-        exit(EXIT_FAILURE);
+// Merges all pending arcs into the CSR adjacency arrays and drops the removed
+// ones, keeping every neighbor row sorted. Does nothing if no arcs are staged.
+void buildAdjacency(Graph G) {
+    if (G->pending_count == 0 && G->removed_count == 0) {
+        return;
     }
-    if (u < 1 || u > getOrder(G) || v < 1 || v > getOrder(G)) {
-        fprintf(stderr, "Graph Error: calling addArc() with invalid vertex/vertices\n");
+
+    int n = G->order;
+    int old_arcs = G->adj_offsets[n + 1];
+    int new_arcs = old_arcs + G->pending_count;
+
+    int *pending_offsets = (int *) malloc((n + 2)*sizeof(int));
+    int *pending_adj = (int *) malloc((G->pending_count > 0 ? G->pending_count : 1)*sizeof(int));
+    int *removed_offsets = (int *) malloc((n + 2)*sizeof(int));
+    int *removed_adj = (int *) malloc((G->removed_count > 0 ? G->removed_count : 1)*sizeof(int));
+    if (pending_offsets == NULL || pending_adj == NULL || removed_offsets == NULL || removed_adj == NULL) {
+        fprintf(stderr, "Graph Error: out of memory while building adjacency\n");
         exit(EXIT_FAILURE);
     }
+    sortArcs(n, G->pending_src, G->pending_dst, G->pending_count, pending_offsets, pending_adj);
+    sortArcs(n, G->removed_src, G->removed_dst, G->removed_count, removed_offsets, removed_adj);
 
-    if (length(G->list_array[u]) == 0) {
-        append(G->list_array[u], v);
-    } else {
-        int j;
-        moveFront(G->list_array[u]);
-            while (index(G->list_array[u]) != -1) {
-                j = get(G->list_array[u]);
-                if (v < j) {
-                    insertBefore(G->list_array[u], v);
-                    break;
-                }
-                moveNext(G->list_array[u]);
+    // Merges each existing row with its sorted pending row, skipping one copy of
+    // every neighbor in its sorted removed row as it goes by.
+    int *offsets = (int *) malloc((n + 2)*sizeof(int));
+    int *adj = (int *) malloc((new_arcs > 0 ? new_arcs : 1)*sizeof(int));
+    if (offsets == NULL || adj == NULL) {
+        fprintf(stderr, "Graph Error: out of memory while building adjacency\n");
+        exit(EXIT_FAILURE);
+    }
+    offsets[0] = offsets[1] = 0;
+    int k = 0;
+    for (int u = 1; u < n + 1; u += 1) {
+        int i = G->adj_offsets[u];
+        int j = pending_offsets[u];
+        int r = removed_offsets[u];
+        while (i < G->adj_offsets[u + 1] || j < pending_offsets[u + 1]) {
+            int v;
+            if (i == G->adj_offsets[u + 1] || (j < pending_offsets[u + 1] && pending_adj[j] < G->adj[i])) {
+                v = pending_adj[j++];
+            } else {
+                v = G->adj[i++];
             }
-            if (index(G->list_array[u]) == -1) {
-                append(G->list_array[u], v);
+            if (r < removed_offsets[u + 1] && removed_adj[r] == v) {
+                r += 1;
+            } else {
+                adj[k++] = v;
             }
+        }
+        if (r < removed_offsets[u + 1]) {
+            fprintf(stderr, "Graph Error: calling removeArc() on an arc that is not in G\n");
+            exit(EXIT_FAILURE);
+        }
+        offsets[u + 1] = k;
     }
-    G->size += 1;
+
+    releaseAdjacency(G);
+    G->adj_offsets = offsets;
+    G->adj = adj;
+
+    free(pending_offsets);
+    free(pending_adj);
+    free(removed_offsets);
+    free(removed_adj);
+    free(G->pending_src);
+    free(G->pending_dst);
+    free(G->removed_src);
+    free(G->removed_dst);
+    free(G->removed_table);
+    G->pending_src = G->pending_dst = NULL;
+    G->pending_count = G->pending_capacity = 0;
+    G->removed_src = G->removed_dst = NULL;
+    G->removed_count = G->removed_capacity = 0;
+    G->removed_table = NULL;
+    G->removed_slots = 0;
     return;
 }
 
-// Performs DFS on the given graph G, pushing vertices onto the "stack" S.
-// Pre: length(S) == getOrder(G) (the order of the graph/number of vertices).
-void DFS(Graph G, List S) {
-    if (G == NULL) {
-        fprintf(stderr, "Graph Error: calling DFS() on NULL Graph reference\n");
-        exit(EXIT_FAILURE);
+// Thread body for reverseArcs(). Counts the heads of the thread's arcs, turns the
+// per-thread counts of its share of the vertices into row offsets and per-thread
+// starting points, then scatters its sources into the reversed rows. Each row gets
+// the sources of thread 0 first, then those of thread 1, and so on, each in
+// increasing order, so every row comes out sorted whatever the thread count.
+void *reverseWorker(void *arg) {
+    ReverseWorker *W = (ReverseWorker *) arg;
+    ReverseFill *R = W->R;
+    Graph G = R->G;
+    int n = G->order;
+    int stride = n + 2;
+    int *count = R->counts + (size_t) W->id*stride;
+    int lo = 1 + (int) ((long long) n*W->id/R->threads);
+    int hi = 1 + (int) ((long long) n*(W->id + 1)/R->threads);
+
+    for (int v = 0; v < stride; v += 1) {
+        count[v] = 0;
     }
-    if (length(S) != getOrder(G)) {
-        fprintf(stderr, "Graph Error: calling DFS() with invalid stack\n");
-        exit(EXIT_FAILURE);
+    for (int j = G->adj_offsets[R->first[W->id]]; j < G->adj_offsets[R->first[W->id + 1]]; j += 1) {
+        count[G->adj[j]] += 1;
     }
+    pthread_barrier_wait(&R->barrier);
 
-    int time = 0;
-    int stack_vertex;
-    List S_copy = copyList(S);
-    clear(S);
+    // Replaces each count by the number of in-arcs of v from earlier threads, and
+    // leaves the in-degree of v in offsets[v + 1].
+    long long total = 0;
+    for (int v = lo; v < hi; v += 1) {
+        int row = 0;
+        for (int t = 0; t < R->threads; t += 1) {
+            int c = R->counts[(size_t) t*stride + v];
+            R->counts[(size_t) t*stride + v] = row;
+            row += c;
+        }
+        R->offsets[v + 1] = row;
+        total += row;
+    }
+    R->totals[W->id] = total;
+    if (pthread_barrier_wait(&R->barrier) == PTHREAD_BARRIER_SERIAL_THREAD) {
+        long long sum = 0;
+        for (int t = 0; t < R->threads; t += 1) {
+            long long c = R->totals[t];
+            R->totals[t] = sum;
+            sum += c;
+        }
+    }
+    pthread_barrier_wait(&R->barrier);
 
-    // Initializing vertices to undiscovered and parents to NIL.
-    for (int i = 1; i < getOrder(G) + 1; i += 1) {
-        G->color_array[i] = WHITE;
+    int end = (int) R->totals[W->id];
+    for (int v = lo; v < hi; v += 1) {
+        end += R->offsets[v + 1];
+        R->offsets[v + 1] = end;
     }
-    for (int i = 1; i < getOrder(G) + 1; i += 1) {
-        G->parent_array[i] = NIL;
+    pthread_barrier_wait(&R->barrier);
+
+    for (int u = R->first[W->id]; u < R->first[W->id + 1]; u += 1) {
+        for (int j = G->adj_offsets[u]; j < G->adj_offsets[u + 1]; j += 1) {
+            int w = G->adj[j];
+            R->adj[R->offsets[w] + count[w]] = u;
+            count[w] += 1;
+        }
+    }
+    return NULL;
+}
+
+// Fills offsets (n + 2 entries) and adj (one entry per arc) with the in-neighbors
+// of every vertex of G, each row sorted. Large graphs are reversed by several
+// threads (one per online processor, at most one per REVERSE_GRAIN arcs, and few
+// enough that their histograms take at most twice the room of G's CSR arrays); the
+// result is the same for any thread count. Pre: the adjacency of G is built.
+void reverseArcs(Graph G, int *offsets, int *adj) {
+    int n = G->order;
+    int arcs = G->adj_offsets[n + 1];
+
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    long long threads = (online > 0) ? online : 1;
+    if (threads > arcs/REVERSE_GRAIN) {
+        threads = arcs/REVERSE_GRAIN;
+    }
+    if (threads > 2*((long long) arcs + n + 2)/(n + 2)) {
+        threads = 2*((long long) arcs + n + 2)/(n + 2);
+    }
+    if (threads < 1) {
+        threads = 1;
+    }
+
+    ReverseFill R;
+    R.G = G;
+    R.offsets = offsets;
+    R.adj = adj;
+    R.threads = (int) threads;
+    R.first = (int *) malloc((R.threads + 1)*sizeof(int));
+    R.counts = (int *) malloc((size_t) R.threads*(n + 2)*sizeof(int));
+    R.totals = (long long *) malloc(R.threads*sizeof(long long));
+    pthread_t *handles = (pthread_t *) malloc(R.threads*sizeof(pthread_t));
+    ReverseWorker *workers = (ReverseWorker *) malloc(R.threads*sizeof(ReverseWorker));
+    if (R.first == NULL || R.counts == NULL || R.totals == NULL || handles == NULL || workers == NULL) {
+        fprintf(stderr, "Graph Error: out of memory while reversing arcs\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Splits the sources into ranges of about arcs/threads out-arcs each.
+    R.first[0] = 1;
+    for (int t = 1; t < R.threads; t += 1) {
+        long long target = (long long) arcs*t/R.threads;
+        int low = R.first[t - 1];
+        int high = n + 1;
+        while (low < high) {
+            int mid = low + (high - low)/2;
+            if (G->adj_offsets[mid] < target) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        R.first[t] = low;
     }
+    R.first[R.threads] = n + 1;
+    offsets[0] = offsets[1] = 0;
 
-    moveFront(S_copy);
-    for (int i = 0; i < length(S_copy); i += 1) {
-        stack_vertex = get(S_copy);
-        if (G->color_array[stack_vertex] == WHITE) {
-            visit(G, S, stack_vertex, &time);
+    pthread_barrier_init(&R.barrier, NULL, R.threads);
+    for (int t = 1; t < R.threads; t += 1) {
+        workers[t].R = &R;
+        workers[t].id = t;
+        if (pthread_create(&handles[t], NULL, reverseWorker, &workers[t]) != 0) {
+            fprintf(stderr, "Graph Error: unable to start threads while reversing arcs\n");
+            exit(EXIT_FAILURE);
         }
-        moveNext(S_copy);
     }
+    workers[0].R = &R;
+    workers[0].id = 0;
+    reverseWorker(&workers[0]);
+    for (int t = 1; t < R.threads; t += 1) {
+        pthread_join(handles[t], NULL);
+    }
+    pthread_barrier_destroy(&R.barrier);
 
-    freeList(&S_copy);
+    free(R.first);
+    free(R.counts);
+    free(R.totals);
+    free(handles);
+    free(workers);
     return;
 }
 
-// Other operations ------------------------------------------------------------
+// Builds the reverse index of G if it is not already there.
+// Pre: the adjacency of G is built.
+void buildReverse(Graph G) {
+    if (G->radj_offsets != NULL) {
+        return;
+    }
 
-// Returns a new transpose graph of a graph G.
-Graph transpose(Graph G) {
-    if (G == NULL) {
-        fprintf(stderr, "Graph Error: calling transpose() on NULL Graph reference\n");
+    int n = G->order;
+    int arcs = G->adj_offsets[n + 1];
+    G->radj_offsets = (int *) malloc((n + 2)*sizeof(int));
+    G->radj = (int *) malloc((arcs > 0 ? arcs : 1)*sizeof(int));
+    if (G->radj_offsets == NULL || G->radj == NULL) {
+        fprintf(stderr, "Graph Error: out of memory while building reverse index\n");
         exit(EXIT_FAILURE);
     }
-    
-    int adjacent_vert;
-    Graph transpose = newGraph(getOrder(G));
+    reverseArcs(G, G->radj_offsets, G->radj);
+    return;
+}
 
-    for (int i = 1; i < getOrder(G) + 1; i += 1) {
-        moveFront(G->list_array[i]);
-        for (int j = 0; j < length(G->list_array[i]); j += 1) {
-            adjacent_vert = get(G->list_array[i]);
-            append(transpose->list_array[adjacent_vert], i);
-            moveNext(G->list_array[i]);
+// Finds the strongly connected components of the subgraph of G induced by the
+// vertices v with exclude[v] == 0 (all vertices if exclude is NULL) in a single
+// depth-first pass, using Pearce's space-efficient variant of Tarjan's algorithm.
+// Writes component ids 1, 2, ... in topological order into rindex, leaves excluded
+// vertices at 0, and returns the number of components. Like depthFirst(), records
+// the number of vertices visited and the deepest stack in G->visited and G->max_depth.
+int pearceComponents(Graph G, int *rindex, const int *exclude) {
+    int n = G->order;
+
+    // rindex[v] is 0 while v is unvisited, its visit index while v is on the DFS
+    // or component stack, and its component label (counting down from n) once done.
+    int *comp_stack = (int *) malloc((n + 1)*sizeof(int));
+    SCCFrame *stack = (SCCFrame *) malloc((n + 1)*sizeof(SCCFrame));
+    if (comp_stack == NULL || stack == NULL) {
+        fprintf(stderr, "Graph Error: out of memory while finding components\n");
+        exit(EXIT_FAILURE);
+    }
+    int comp_top = 0;
+    int next_index = 1;
+    int label = n;
+    int visited = 0;
+    int max_depth = 0;
+
+    for (int i = 1; i < n + 1; i += 1) {
+        rindex[i] = 0;
+    }
+
+    for (int r = 1; r < n + 1; r += 1) {
+        if (rindex[r] != 0 || (exclude != NULL && exclude[r] != 0)) {
+            continue;
+        }
+        int depth = 0;
+        rindex[r] = next_index++;
+        visited += 1;
+        stack[0].vertex = r;
+        stack[0].next = G->adj_offsets[r];
+        stack[0].root = true;
+
+        while (depth >= 0) {
+            SCCFrame *frame = &stack[depth];
+            int v = frame->vertex;
+            int end = G->adj_offsets[v + 1];
+
+            // Absorbs the lowlinks of already-visited neighbors until an unvisited one is found.
+            while (frame->next < end && (rindex[G->adj[frame->next]] != 0
+                    || (exclude != NULL && exclude[G->adj[frame->next]] != 0))) {
+                int w = G->adj[frame->next];
+                if (rindex[w] < rindex[v] && (exclude == NULL || exclude[w] == 0)) {
+                    rindex[v] = rindex[w];
+                    frame->root = false;
+                }
+                frame->next += 1;
+            }
+
+            if (frame->next < end) {
+                // Descends into w; its lowlink is absorbed by the loop above once it returns.
+                int w = G->adj[frame->next];
+                rindex[w] = next_index++;
+                visited += 1;
+                depth += 1;
+                if (depth > max_depth) {
+                    max_depth = depth;
+                }
+                stack[depth].vertex = w;
+                stack[depth].next = G->adj_offsets[w];
+                stack[depth].root = true;
+                continue;
+            }
+
+            if (frame->root) {
+                // v is the root of a component: pop its members and label them.
+                next_index -= 1;
+                while (comp_top > 0 && rindex[v] <= rindex[comp_stack[comp_top - 1]]) {
+                    comp_top -= 1;
+                    rindex[comp_stack[comp_top]] = label;
+                    next_index -= 1;
+                }
+                rindex[v] = label;
+                label -= 1;
+            } else {
+                comp_stack[comp_top++] = v;
+            }
+            depth -= 1;
         }
     }
-    return transpose;
-}
 
-// Returns a new copy of graph G.
-Graph copyGraph(Graph G) {
-    if (G == NULL) {
-        fprintf(stderr, "Graph Error: calling copyGraph() on NULL Graph reference\n");
-        exit(EXIT_FAILURE);
+    // Components were labelled n, n-1, ... in reverse topological order.
+    for (int i = 1; i < n + 1; i += 1) {
+        if (rindex[i] != 0) {
+            rindex[i] -= label;
+        }
     }
 
-    int adjacent_vert;
-    Graph copy = newGraph(getOrder(G));
+    free(comp_stack);
+    free(stack);
+    G->visited = visited;
+    G->max_depth = (visited > 0) ? max_depth + 1 : 0;
+    return n - label;
+}
 
-    for (int i = 1; i < getOrder(G) + 1; i += 1) {
-    moveFront(G->list_array[i]);
-        for (int j = 0; j < length(G->list_array[i]); j += 1) {
-            adjacent_vert = get(G->list_array[i]);
-            append(copy->list_array[i], adjacent_vert);
-            moveNext(G->list_array[i]);
+// Returns true if v has a neighbor w != v in the CSR rows offsets/adj that is
+// still unassigned in component.
+bool hasLiveNeighbor(const int *offsets, const int *adj, int v, const int *component) {
+    for (int i = offsets[v]; i < offsets[v + 1]; i += 1) {
+        int w = adj[i];
+        if (w != v && component[w] == 0) {
+            return true;
         }
     }
-    return copy;
+    return false;
 }
 
-// Prints the Graph G to out.
-void printGraph(FILE* out, Graph G) {
-    if (G == NULL) {
+// Level-synchronous parallel BFS over the CSR rows offsets/adj from the vertices in P->frontier, limited to
+// unassigned vertices, that sets bit in reach[] for every vertex it reaches. Every
+// worker thread calls it; threads claim frontier chunks of BFS_CHUNK vertices and
+// collect newly reached vertices in buffer (BFS_CHUNK entries) before publishing them.
+void reachFromPivot(ParallelSCC *P, const int *offsets, const int *adj, unsigned char bit, int *buffer) {
+    while (true) {
+        int start;
+        int count = 0;
+        while ((start = atomic_fetch_add(&P->frontier_pos, BFS_CHUNK)) < P->frontier_size) {
+            int end = (start + BFS_CHUNK < P->frontier_size) ? start + BFS_CHUNK : P->frontier_size;
+            for (int i = start; i < end; i += 1) {
+                int v = P->frontier[i];
+                for (int j = offsets[v]; j < offsets[v + 1]; j += 1) {
+                    int w = adj[j];
+                    if (P->component[w] != 0 || (atomic_load(&P->reach[w]) & bit) != 0) {
+                        continue;
+                    }
+                    if ((atomic_fetch_or(&P->reach[w], bit) & bit) == 0) {
+                        buffer[count++] = w;
+                        if (count == BFS_CHUNK) {
+                            int pos = atomic_fetch_add(&P->next_size, count);
+                            memcpy(P->next_frontier + pos, buffer, count*sizeof(int));
+                            count = 0;
+                        }
+                    }
+                }
+            }
+        }
+        if (count > 0) {
+            int pos = atomic_fetch_add(&P->next_size, count);
+            memcpy(P->next_frontier + pos, buffer, count*sizeof(int));
+        }
+
+        // Every thread waits for the level to finish; the serial thread then swaps
+        // frontiers, and expands levels on its own while they are too small to share.
+        if (pthread_barrier_wait(&P->barrier) == PTHREAD_BARRIER_SERIAL_THREAD) {
+            int *swap = P->frontier;
+            P->frontier = P->next_frontier;
+            P->next_frontier = swap;
+            P->frontier_size = atomic_load(&P->next_size);
+            while (P->frontier_size > 0 && P->frontier_size < BFS_CHUNK) {
+                int size = 0;
+                for (int i = 0; i < P->frontier_size; i += 1) {
+                    int v = P->frontier[i];
+                    for (int j = offsets[v]; j < offsets[v + 1]; j += 1) {
+                        int w = adj[j];
+                        if (P->component[w] == 0 && (atomic_fetch_or(&P->reach[w], bit) & bit) == 0) {
+                            P->next_frontier[size++] = w;
+                        }
+                    }
+                }
+                swap = P->frontier;
+                P->frontier = P->next_frontier;
+                P->next_frontier = swap;
+                P->frontier_size = size;
+            }
+            atomic_store(&P->next_size, 0);
+            atomic_store(&P->frontier_pos, 0);
+        }
+        pthread_barrier_wait(&P->barrier);
+        if (P->frontier_size == 0) {
+            return;
+        }
+    }
+}
+
+// Thread body for parallelSCC(). Each worker owns a contiguous range of vertices
+// and takes part in three barrier-separated phases: up to TRIM_ROUNDS rounds of
+// trimming vertices with no unassigned in- or out-neighbor, choosing a pivot of
+// maximum degree, and a forward-backward search that labels the pivot's component.
+void *sccWorker(void *arg) {
+    SCCWorker *W = (SCCWorker *) arg;
+    ParallelSCC *P = W->P;
+    Graph G = P->G;
+    int n = G->order;
+    int lo = 1 + (int) ((long long) n*W->id/P->threads);
+    int hi = 1 + (int) ((long long) n*(W->id + 1)/P->threads);
+    int *trimmed = (int *) malloc(((hi - lo) > 0 ? hi - lo : 1)*sizeof(int));
+    int *buffer = (int *) malloc(BFS_CHUNK*sizeof(int));
+    if (trimmed == NULL || buffer == NULL) {
+        fprintf(stderr, "Graph Error: out of memory in parallelSCC()\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Trimming: a vertex without unassigned in- or out-neighbors is its own component.
+    for (int round = 0; round < TRIM_ROUNDS; round += 1) {
+        int count = 0;
+        for (int v = lo; v < hi; v += 1) {
+            if (P->component[v] == 0
+                    && (!hasLiveNeighbor(G->adj_offsets, G->adj, v, P->component)
+                        || !hasLiveNeighbor(G->radj_offsets, G->radj, v, P->component))) {
+                trimmed[count++] = v;
+            }
+        }
+        pthread_barrier_wait(&P->barrier);
+        if (count > 0) {
+            int label = atomic_fetch_add(&P->next_label, count);
+            for (int i = 0; i < count; i += 1) {
+                P->component[trimmed[i]] = label + i;
+            }
+            atomic_fetch_add(&P->trimmed, count);
+        }
+        pthread_barrier_wait(&P->barrier);
+        int total = atomic_load(&P->trimmed);
+        if (pthread_barrier_wait(&P->barrier) == PTHREAD_BARRIER_SERIAL_THREAD) {
+            atomic_store(&P->trimmed, 0);
+        }
+        if (total == 0) {
+            break;
+        }
+    }
+
+    // Pivot selection: the unassigned vertex maximizing (in-degree + 1)*(out-degree + 1).
+    P->best_vertex[W->id] = 0;
+    P->best_score[W->id] = -1;
+    for (int v = lo; v < hi; v += 1) {
+        if (P->component[v] == 0) {
+            long long out_degree = G->adj_offsets[v + 1] - G->adj_offsets[v];
+            long long in_degree = G->radj_offsets[v + 1] - G->radj_offsets[v];
+            long long score = (in_degree + 1)*(out_degree + 1);
+            if (score > P->best_score[W->id]) {
+                P->best_score[W->id] = score;
+                P->best_vertex[W->id] = v;
+            }
+        }
+    }
+    if (pthread_barrier_wait(&P->barrier) == PTHREAD_BARRIER_SERIAL_THREAD) {
+        P->pivot = 0;
+        long long best = -1;
+        for (int t = 0; t < P->threads; t += 1) {
+            if (P->best_score[t] > best) {
+                best = P->best_score[t];
+                P->pivot = P->best_vertex[t];
+            }
+        }
+        if (P->pivot != 0) {
+            atomic_store(&P->reach[P->pivot], 1);
+            P->frontier[0] = P->pivot;
+            P->frontier_size = 1;
+        }
+    }
+    pthread_barrier_wait(&P->barrier);
+
+    // Forward-backward search: the pivot's component is everything reached both ways.
+    if (P->pivot != 0) {
+        reachFromPivot(P, G->adj_offsets, G->adj, 1, buffer);
+        if (pthread_barrier_wait(&P->barrier) == PTHREAD_BARRIER_SERIAL_THREAD) {
+            atomic_fetch_or(&P->reach[P->pivot], 2);
+            P->frontier[0] = P->pivot;
+            P->frontier_size = 1;
+            P->pivot_label = atomic_fetch_add(&P->next_label, 1);
+        }
+        pthread_barrier_wait(&P->barrier);
+        reachFromPivot(P, G->radj_offsets, G->radj, 2, buffer);
+        for (int v = lo; v < hi; v += 1) {
+            if (P->component[v] == 0 && atomic_load(&P->reach[v]) == 3) {
+                P->component[v] = P->pivot_label;
+            }
+        }
+    }
+
+    free(trimmed);
+    free(buffer);
+    return NULL;
+}
+
+// Renumbers the count components in component[1..n] as 1, 2, ..., count in a
+// topological order of the component DAG (Kahn's algorithm, ties broken by old label).
+void numberTopologically(Graph G, int *component, int count) {
+    int n = G->order;
+    int *in_degree = (int *) calloc(count + 1, sizeof(int));
+    int *offsets = (int *) calloc(count + 2, sizeof(int));
+    int *members = (int *) malloc((n > 0 ? n : 1)*sizeof(int));
+    int *queue = (int *) malloc((count + 1)*sizeof(int));
+    int *number = (int *) malloc((count + 1)*sizeof(int));
+    if (in_degree == NULL || offsets == NULL || members == NULL || queue == NULL || number == NULL) {
+        fprintf(stderr, "Graph Error: out of memory while numbering components\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Groups the vertices by component and counts the arcs entering each component.
+    for (int v = 1; v < n + 1; v += 1) {
+        offsets[component[v] + 1] += 1;
+        for (int i = G->adj_offsets[v]; i < G->adj_offsets[v + 1]; i += 1) {
+            if (component[G->adj[i]] != component[v]) {
+                in_degree[component[G->adj[i]]] += 1;
+            }
+        }
+    }
+    for (int c = 1; c < count + 1; c += 1) {
+        offsets[c + 1] += offsets[c];
+    }
+    for (int v = 1; v < n + 1; v += 1) {
+        members[offsets[component[v]]] = v;
+        offsets[component[v]] += 1;
+    }
+    for (int c = count; c > 0; c -= 1) {
+        offsets[c] = offsets[c - 1];
+    }
+    offsets[0] = 0;
+
+    int head = 0;
+    int tail = 0;
+    for (int c = 1; c < count + 1; c += 1) {
+        if (in_degree[c] == 0) {
+            queue[tail++] = c;
+        }
+    }
+    while (head < tail) {
+        int c = queue[head++];
+        number[c] = head;
+        for (int k = offsets[c]; k < offsets[c + 1]; k += 1) {
+            int v = members[k];
+            for (int i = G->adj_offsets[v]; i < G->adj_offsets[v + 1]; i += 1) {
+                int d = component[G->adj[i]];
+                if (d != c) {
+                    in_degree[d] -= 1;
+                    if (in_degree[d] == 0) {
+                        queue[tail++] = d;
+                    }
+                }
+            }
+        }
+    }
+    for (int v = 1; v < n + 1; v += 1) {
+        component[v] = number[component[v]];
+    }
+
+    free(in_degree);
+    free(offsets);
+    free(members);
+    free(queue);
+    free(number);
+    return;
+}
+
+// Releases the CSR arrays of G, unmapping them if they came from loadGraph(),
+// and the reverse index built from them.
+void releaseAdjacency(Graph G) {
+    free(G->radj_offsets);
+    free(G->radj);
+    G->radj_offsets = NULL;
+    G->radj = NULL;
+    if (G->mapping != NULL) {
+        munmap(G->mapping, G->mapping_length);
+        G->mapping = NULL;
+        G->mapping_length = 0;
+    } else {
+        free(G->adj_offsets);
+        free(G->adj);
+    }
+    G->adj_offsets = NULL;
+    G->adj = NULL;
+    return;
+}
+
+// Fletcher-64 style checksum over 32-bit words, continuing from state
+// (pass 0 to start a new checksum). The sums are reduced once per block of
+// words rather than per word; they cannot overflow 64 bits within a block.
+uint64_t checksumWords(const int *words, size_t count, uint64_t state) {
+    uint64_t low = state & 0xffffffffu;
+    uint64_t high = state >> 32;
+    size_t i = 0;
+    while (i < count) {
+        size_t block_end = (count - i > 1024) ? i + 1024 : count;
+        for (; i < block_end; i += 1) {
+            low += (uint32_t) words[i];
+            high += low;
+        }
+        low %= 0xffffffffu;
+        high %= 0xffffffffu;
+    }
+    return (high << 32) | low;
+}
+
+// Returns the live component that component c has been merged into (c itself if
+// c is live), halving the path to it on the way.
+int findLeader(DynamicSCC D, int c) {
+    int *leader = D->leader;
+    while (leader[c] != c) {
+        leader[c] = leader[leader[c]];
+        c = leader[c];
+    }
+    return c;
+}
+
+// Appends the arc tail -> head to B, doubling its capacity as needed.
+void pushArc(ArcBuffer *B, int tail, int head) {
+    if (B->count == B->capacity) {
+        int capacity = (B->capacity == 0) ? 4 : 2*B->capacity;
+        int *arcs = B->owned ? (int *) realloc(B->arcs, 2*capacity*sizeof(int))
+                             : (int *) malloc(2*capacity*sizeof(int));
+        if (arcs == NULL) {
+            fprintf(stderr, "Graph Error: out of memory while updating components\n");
+            exit(EXIT_FAILURE);
+        }
+        if (!B->owned) {
+            memcpy(arcs, B->arcs, 2*B->count*sizeof(int));
+        }
+        B->arcs = arcs;
+        B->capacity = capacity;
+        B->owned = true;
+    }
+    B->arcs[2*B->count] = tail;
+    B->arcs[2*B->count + 1] = head;
+    B->count += 1;
+    return;
+}
+
+// Removes one copy of the arc tail -> head from B, if there is one, by moving the
+// last arc of B into its slot.
+void dropArc(ArcBuffer *B, int tail, int head) {
+    for (int i = 0; i < B->count; i += 1) {
+        if (B->arcs[2*i] == tail && B->arcs[2*i + 1] == head) {
+            B->count -= 1;
+            B->arcs[2*i] = B->arcs[2*B->count];
+            B->arcs[2*i + 1] = B->arcs[2*B->count + 1];
+            return;
+        }
+    }
+    return;
+}
+
+// Empties B, freeing its arcs unless they live in the shared pool.
+void releaseArcs(ArcBuffer *B) {
+    if (B->owned) {
+        free(B->arcs);
+    }
+    B->arcs = NULL;
+    B->count = B->capacity = 0;
+    B->owned = true;
+    return;
+}
+
+// Starts a new search by advancing the stamp that marks visited components,
+// clearing all marks when it would overflow.
+void nextStamp(DynamicSCC D) {
+    if (D->stamp == INT_MAX) {
+        memset(D->forward_mark, 0, (D->capacity + 1)*sizeof(int));
+        memset(D->backward_mark, 0, (D->capacity + 1)*sizeof(int));
+        D->stamp = 0;
+    }
+    D->stamp += 1;
+    return;
+}
+
+// Returns a fresh component label with no members and no arcs, doubling the
+// arrays indexed by label as needed.
+int newLabel(DynamicSCC D) {
+    if (D->labels == D->capacity) {
+        int capacity = 2*D->capacity + 1;
+        D->out = (ArcBuffer *) realloc(D->out, (capacity + 1)*sizeof(ArcBuffer));
+        D->in = (ArcBuffer *) realloc(D->in, (capacity + 1)*sizeof(ArcBuffer));
+        D->leader = (int *) realloc(D->leader, (capacity + 1)*sizeof(int));
+        D->member = (int *) realloc(D->member, (capacity + 1)*sizeof(int));
+        D->position = (int *) realloc(D->position, (capacity + 1)*sizeof(int));
+        D->forward_mark = (int *) realloc(D->forward_mark, (capacity + 1)*sizeof(int));
+        D->backward_mark = (int *) realloc(D->backward_mark, (capacity + 1)*sizeof(int));
+        if (D->out == NULL || D->in == NULL || D->leader == NULL || D->member == NULL
+            || D->position == NULL || D->forward_mark == NULL || D->backward_mark == NULL) {
+            fprintf(stderr, "Graph Error: out of memory while updating components\n");
+            exit(EXIT_FAILURE);
+        }
+        D->capacity = capacity;
+    }
+    D->labels += 1;
+    int c = D->labels;
+    D->out[c].arcs = D->in[c].arcs = NULL;
+    D->out[c].count = D->in[c].count = 0;
+    D->out[c].capacity = D->in[c].capacity = 0;
+    D->out[c].owned = D->in[c].owned = true;
+    D->leader[c] = c;
+    D->member[c] = 0;
+    D->position[c] = 0;
+    D->forward_mark[c] = D->backward_mark[c] = 0;
+    return c;
+}
+
+// Collects into found the live components reachable from c (forward) or from which
+// c is reachable (backward) through components placed within [low, high], starting
+// with c itself, marks them with the current stamp and returns how many there are.
+int searchComponents(DynamicSCC D, int c, bool forward, int low, int high, int *found) {
+    ArcBuffer *arcs = forward ? D->out : D->in;
+    int *mark = forward ? D->forward_mark : D->backward_mark;
+    int count = 1;
+    found[0] = c;
+    mark[c] = D->stamp;
+    for (int k = 0; k < count; k += 1) {
+        int x = found[k];
+        for (int i = 0; i < arcs[x].count; i += 1) {
+            int y = arcs[x].arcs[forward ? 2*i + 1 : 2*i];
+            int w = findLeader(D, D->label[y]);
+            if (w == x || mark[w] == D->stamp || D->position[w] < low || D->position[w] > high) {
+                continue;
+            }
+            mark[w] = D->stamp;
+            found[count] = w;
+            count += 1;
+        }
+    }
+    return count;
+}
+
+// Merges the count components listed in members into their member rep, joining
+// their member lists and moving the arcs of the others over to rep.
+void mergeComponents(DynamicSCC D, int rep, const int *members, int count) {
+    for (int k = 0; k < count; k += 1) {
+        D->leader[members[k]] = rep;
+    }
+    for (int k = 0; k < count; k += 1) {
+        int c = members[k];
+        if (c == rep) {
+            continue;
+        }
+        int a = D->member[rep];
+        int b = D->member[c];
+        int next = D->next_member[a];
+        D->next_member[a] = D->next_member[b];
+        D->next_member[b] = next;
+        D->member[c] = 0;
+
+        for (int i = 0; i < D->out[c].count; i += 1) {
+            int tail = D->out[c].arcs[2*i];
+            int head = D->out[c].arcs[2*i + 1];
+            if (findLeader(D, D->label[head]) != rep) {
+                pushArc(&D->out[rep], tail, head);
+            }
+        }
+        for (int i = 0; i < D->in[c].count; i += 1) {
+            int tail = D->in[c].arcs[2*i];
+            int head = D->in[c].arcs[2*i + 1];
+            if (findLeader(D, D->label[tail]) != rep) {
+                pushArc(&D->in[rep], tail, head);
+            }
+        }
+        releaseArcs(&D->out[c]);
+        releaseArcs(&D->in[c]);
+    }
+    D->count -= count - 1;
+    return;
+}
+
+// Recomputes the SCC's of the subgraph of G induced by the members of live
+// component c. If c has fallen apart, relabels its members and splits its arcs
+// among the new components. Writes the labels of the resulting components, in
+// topological order and starting with c, into pieces and returns their number.
+int splitComponent(DynamicSCC D, int c, int *pieces) {
+    Graph G = D->G;
+    int *members = D->sequence;
+    int size = 0;
+    int x = D->member[c];
+    do {
+        members[size] = x;
+        size += 1;
+        D->local[x] = size;
+        x = D->next_member[x];
+    } while (x != D->member[c]);
+
+    int arcs = 0;
+    for (int k = 0; k < size; k += 1) {
+        arcs += G->adj_offsets[members[k] + 1] - G->adj_offsets[members[k]];
+    }
+    int *src = (int *) malloc((arcs > 0 ? arcs : 1)*sizeof(int));
+    int *dst = (int *) malloc((arcs > 0 ? arcs : 1)*sizeof(int));
+    int *sub = (int *) malloc((size + 1)*sizeof(int));
+    if (src == NULL || dst == NULL || sub == NULL) {
+        fprintf(stderr, "Graph Error: out of memory while updating components\n");
+        exit(EXIT_FAILURE);
+    }
+    int m = 0;
+    for (int k = 0; k < size; k += 1) {
+        for (int i = G->adj_offsets[members[k]]; i < G->adj_offsets[members[k] + 1]; i += 1) {
+            if (D->local[G->adj[i]] != 0) {
+                src[m] = k + 1;
+                dst[m] = D->local[G->adj[i]];
+                m += 1;
+            }
+        }
+    }
+    Graph H = newGraphFromEdges(size, src, dst, m);
+    int parts = SCC(H, sub);
+
+    pieces[0] = c;
+    if (parts > 1) {
+        for (int j = 1; j < parts; j += 1) {
+            pieces[j] = newLabel(D);
+        }
+        ArcBuffer out = D->out[c];
+        ArcBuffer in = D->in[c];
+        D->out[c].arcs = D->in[c].arcs = NULL;
+        D->out[c].count = D->in[c].count = 0;
+        D->out[c].capacity = D->in[c].capacity = 0;
+        D->out[c].owned = D->in[c].owned = true;
+
+        D->member[c] = 0;
+        for (int k = 0; k < size; k += 1) {
+            int v = members[k];
+            int l = pieces[sub[k + 1] - 1];
+            D->label[v] = l;
+            if (D->member[l] == 0) {
+                D->member[l] = v;
+                D->next_member[v] = v;
+            } else {
+                D->next_member[v] = D->next_member[D->member[l]];
+                D->next_member[D->member[l]] = v;
+            }
+        }
+
+        // Arcs to and from the rest of G keep their outside end; arcs inside c
+        // are taken afresh from G, which also drops any left over from merges.
+        for (int i = 0; i < out.count; i += 1) {
+            if (D->local[out.arcs[2*i + 1]] == 0) {
+                pushArc(&D->out[D->label[out.arcs[2*i]]], out.arcs[2*i], out.arcs[2*i + 1]);
+            }
+        }
+        for (int i = 0; i < in.count; i += 1) {
+            if (D->local[in.arcs[2*i]] == 0) {
+                pushArc(&D->in[D->label[in.arcs[2*i + 1]]], in.arcs[2*i], in.arcs[2*i + 1]);
+            }
+        }
+        releaseArcs(&out);
+        releaseArcs(&in);
+        for (int e = 0; e < m; e += 1) {
+            int tail = members[src[e] - 1];
+            int head = members[dst[e] - 1];
+            if (D->label[tail] != D->label[head]) {
+                pushArc(&D->out[D->label[tail]], tail, head);
+                pushArc(&D->in[D->label[head]], tail, head);
+            }
+        }
+        D->count += parts - 1;
+    }
+
+    for (int k = 0; k < size; k += 1) {
+        D->local[members[k]] = 0;
+    }
+    freeGraph(&H);
+    free(src);
+    free(dst);
+    free(sub);
+    return parts;
+}
+
+// qsort() comparison function for ints in increasing order.
+int compareInts(const void *a, const void *b) {
+    int x = *(const int *) a;
+    int y = *(const int *) b;
+    return (x > y) - (x < y);
+}
+
+// Checks the arguments of a search over S->V starting at u.
+void checkSearch(ViewSearch S, int u, const char *caller) {
+    if (S == NULL) {
+        fprintf(stderr, "Graph Error: calling %s() on NULL ViewSearch reference\n", caller);
+        exit(EXIT_FAILURE);
+    }
+    if (u < 1 || u > S->V->order) {
+        fprintf(stderr, "Graph Error: calling %s() with invalid vertex/vertices\n", caller);
+        exit(EXIT_FAILURE);
+    }
+    return;
+}
+
+// Starts a new search on S, after which no vertex counts as visited. Only when
+// the counter would overflow are all stamps cleared.
+void nextEpoch(ViewSearch S) {
+    if (S->epoch == INT_MAX) {
+        memset(S->stamp, 0, (S->V->order + 1)*sizeof(int));
+        S->epoch = 0;
+    }
+    S->epoch += 1;
+    return;
+}
+
+// Fills rank[1..count] and low[1..count] of R with one interval labelling of its
+// condensation: a DFS that starts new trees at the components in a random order
+// and takes the successors of each component from a random starting point.
+void labelComponents(ReachIndex R, int *rank, int *low, uint64_t seed) {
+    Graph C = R->C;
+    int count = R->count;
+    int *roots = (int *) malloc((count > 0 ? count : 1)*sizeof(int));
+    int *first = (int *) malloc((count + 1)*sizeof(int));
+    DFSFrame *stack = (DFSFrame *) malloc((count > 0 ? count : 1)*sizeof(DFSFrame));
+    if (roots == NULL || first == NULL || stack == NULL) {
+        fprintf(stderr, "Graph Error: out of memory in newReachIndex()\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // xorshift64 drives the shuffle of the roots and the rotation of every row.
+    uint64_t x = seed;
+    for (int c = 1; c < count + 1; c += 1) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        int degree = C->adj_offsets[c + 1] - C->adj_offsets[c];
+        first[c] = (degree > 0) ? (int) (x % (uint64_t) degree) : 0;
+        rank[c] = 0;
+        int j = (int) (x % (uint64_t) c);
+        roots[c - 1] = roots[j];
+        roots[j] = c;
+    }
+
+    int next_rank = 1;
+    for (int i = 0; i < count; i += 1) {
+        if (rank[roots[i]] != 0) {
+            continue;
+        }
+        int depth = 0;
+        stack[0].vertex = roots[i];
+        stack[0].next = 0;
+        rank[roots[i]] = -1;
+        low[roots[i]] = INT_MAX;
+        while (depth >= 0) {
+            DFSFrame *frame = &stack[depth];
+            int c = frame->vertex;
+            int start = C->adj_offsets[c];
+            int degree = C->adj_offsets[c + 1] - start;
+            if (frame->next < degree) {
+                int d = C->adj[start + (first[c] + frame->next) % degree];
+                frame->next += 1;
+                if (rank[d] == 0) {
+                    rank[d] = -1;
+                    low[d] = INT_MAX;
+                    depth += 1;
+                    stack[depth].vertex = d;
+                    stack[depth].next = 0;
+                } else if (low[d] < low[c]) {
+                    low[c] = low[d];
+                }
+                continue;
+            }
+
+            // c is finished: it takes the next rank, and its parent inherits its low.
+            rank[c] = next_rank++;
+            if (rank[c] < low[c]) {
+                low[c] = rank[c];
+            }
+            depth -= 1;
+            if (depth >= 0 && low[c] < low[stack[depth].vertex]) {
+                low[stack[depth].vertex] = low[c];
+            }
+        }
+    }
+
+    free(roots);
+    free(first);
+    free(stack);
+    return;
+}
+
+// Returns false if the levels or any interval labelling of R show that component
+// d cannot be reached from component c, and true if it might be.
+bool mayReach(ReachIndex R, int c, int d) {
+    if (d < c || R->level[d] <= R->level[c]) {
+        return false;
+    }
+    for (int l = 0; l < REACH_LABELS; l += 1) {
+        const int *rank = R->rank + (size_t) l*(R->count + 1);
+        const int *low = R->low + (size_t) l*(R->count + 1);
+        if (rank[d] > rank[c] || low[d] < low[c]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Depth-first search of the condensation of R from component c for component d,
+// which only enters components that mayReach() d.
+bool searchReach(ReachIndex R, int c, int d) {
+    if (R->epoch == INT_MAX) {
+        memset(R->stamp, 0, (R->count + 1)*sizeof(int));
+        R->epoch = 0;
+    }
+    R->epoch += 1;
+
+    Graph C = R->C;
+    int top = 0;
+    R->stack[top++] = c;
+    R->stamp[c] = R->epoch;
+    while (top > 0) {
+        int x = R->stack[--top];
+        for (int i = C->adj_offsets[x]; i < C->adj_offsets[x + 1]; i += 1) {
+            int y = C->adj[i];
+            if (y == d) {
+                return true;
+            }
+            if (R->stamp[y] != R->epoch && mayReach(R, y, d)) {
+                R->stamp[y] = R->epoch;
+                R->stack[top++] = y;
+            }
+        }
+    }
+    return false;
+}
+
+// Constructors-Destructors ---------------------------------------------------
+
+// Graph constructor.
+Graph newGraph(int n) {
+    Graph G = malloc(sizeof(GraphObj));
+    G->adj_offsets = (int *) calloc(n + 2, sizeof(int));
+    G->adj = (int *) malloc(sizeof(int));
+    G->radj_offsets = NULL;
+    G->radj = NULL;
+    G->pending_src = G->pending_dst = NULL;
+    G->pending_count = G->pending_capacity = 0;
+    G->removed_src = G->removed_dst = NULL;
+    G->removed_count = G->removed_capacity = 0;
+    G->removed_table = NULL;
+    G->removed_slots = 0;
+    G->mapping = NULL;
+    G->mapping_length = 0;
+
+    G->state = (VertexState *) malloc((n + 1)*sizeof(VertexState));
+    for (int i = 0; i < n + 1; i += 1) {
+        G->state[i].parent = NIL;
+        G->state[i].discover = UNDEF;
+        G->state[i].finish = UNDEF;
+        G->state[i].stamp = 0;
+    }
+    G->epoch = 0;
+
+    G->order = n;
+    G->size = 0;
+    G->visited = 0;
+    G->max_depth = 0;
+    return G;
+}
+
+// Graph constructor that loads all m arcs (src[i], dst[i]) at once.
+// Builds the sorted adjacency in O(n + m) time instead of inserting arc by arc.
+// Pre: 1 <= src[i] <= n, 1 <= dst[i] <= n for 0 <= i < m
+Graph newGraphFromEdges(int n, const int *src, const int *dst, int m) {
+    if (m < 0 || (m > 0 && (src == NULL || dst == NULL))) {
+        fprintf(stderr, "Graph Error: calling newGraphFromEdges() with invalid arc arrays\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < m; i += 1) {
+        if (src[i] < 1 || src[i] > n || dst[i] < 1 || dst[i] > n) {
+            fprintf(stderr, "Graph Error: calling newGraphFromEdges() with invalid vertex/vertices\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    Graph G = newGraph(n);
+    free(G->adj);
+    G->adj = (int *) malloc((m > 0 ? m : 1)*sizeof(int));
+    if (G->adj == NULL) {
+        fprintf(stderr, "Graph Error: out of memory in newGraphFromEdges()\n");
+        exit(EXIT_FAILURE);
+    }
+    sortArcs(n, src, dst, m, G->adj_offsets, G->adj);
+    G->size = m;
+    return G;
+}
+
+// Graph Destructor.
+void freeGraph(Graph* pG) {
+    if (pG != NULL && *pG != NULL) { 
+        releaseAdjacency(*pG);
+        free((*pG)->pending_src);
+        free((*pG)->pending_dst);
+        free((*pG)->removed_src);
+        free((*pG)->removed_dst);
+        free((*pG)->removed_table);
+        free((*pG)->state);
+        free(*pG);
+        *pG = NULL;
+    }
+    return;
+}
+
+// Accessor functions -----------------------------------------------------------
+
+// Returns the order of the Graph.
+int getOrder(Graph G) {
+    if (G == NULL) {
+        fprintf(stderr, "Graph Error: calling getOrder() on NULL Graph reference\n");
+        exit(EXIT_FAILURE);
+    }
+    return G->order;
+}
+
+// Returns the size of the Graph.
+int getSize(Graph G) {
+    if (G == NULL) {
+        fprintf(stderr, "Graph Error: calling getSize() on NULL Graph reference\n");
+        exit(EXIT_FAILURE);
+    }
+    return G->size;
+}
+
+// Returns the parent of vertex u in the DFS forest created by DFS()
+// Returns NIL if a DFS hasn't ocurred yet (a parent may be NIL even if DFS has occured).
+// Pre: 1 <= u <= getOrder(G) (the order of the graph/number of vertices).
+int getParent(Graph G, int u) {
+#ifndef NDEBUG
+    if (G == NULL) {
+        fprintf(stderr, "Graph Error: calling getParent() on NULL Graph reference\n");
+        exit(EXIT_FAILURE);
+    }
+    if (u < 1 || u > getOrder(G)) {
+        fprintf(stderr, "Graph Error: calling getParent() with invalid vertex/vertices\n");
+        exit(EXIT_FAILURE);
+    }
+#endif
+    return (G->state[u].stamp == G->epoch) ? G->state[u].parent : NIL;
+}
+
+// Returns the discover time of a vertex after DFS().
+// If DFS() hasn't been called, returns UNDEF.
+// Pre: 1 <= u <= getOrder(G) (the order of the graph/number of vertices).
+int getDiscover(Graph G, int u) {
+#ifndef NDEBUG
+    if (G == NULL) {
+        fprintf(stderr, "Graph Error: calling getDiscover() on NULL Graph reference\n");
+        exit(EXIT_FAILURE);
+    }
+    if (u < 1 || u > getOrder(G)) {
+        fprintf(stderr, "Graph Error: calling getDiscover() with invalid vertex/vertices\n");
+        exit(EXIT_FAILURE);
+    }
+#endif
+    return (G->state[u].stamp == G->epoch) ? G->state[u].discover : UNDEF;
+}
+
+// Returns the finish time of a vertex after DFS().
+// If DFS() hasn't been called, returns UNDEF.
+// Pre: 1 <= u <= getOrder(G) (the order of the graph/number of vertices).
+int getFinish(Graph G, int u) {
+#ifndef NDEBUG
+    if (G == NULL) {
+        fprintf(stderr, "Graph Error: calling getFinish() on NULL Graph reference\n");
+        exit(EXIT_FAILURE);
+    }
+    if (u < 1 || u > getOrder(G)) {
+        fprintf(stderr, "Graph Error: calling getFinish() with invalid vertex/vertices\n");
+        exit(EXIT_FAILURE);
+    }
+#endif
+    return (G->state[u].stamp == G->epoch) ? G->state[u].finish : UNDEF;
+}
+
+// Returns the number of vertices visited by the most recent DFS of G.
+int getVisited(Graph G) {
+    if (G == NULL) {
+        fprintf(stderr, "Graph Error: calling getVisited() on NULL Graph reference\n");
+        exit(EXIT_FAILURE);
+    }
+    return G->visited;
+}
+
+// Returns the largest number of vertices on the DFS stack at once (the length of
+// the longest tree path plus one) during the most recent DFS of G.
+int getMaxDepth(Graph G) {
+    if (G == NULL) {
+        fprintf(stderr, "Graph Error: calling getMaxDepth() on NULL Graph reference\n");
+        exit(EXIT_FAILURE);
+    }
+    return G->max_depth;
+}
+
+// Sets *neighbors to the out-neighbors of u, in increasing order, and returns how
+// many there are. The row stays valid until G is changed, so a loop over it needs
+// only this one checked call per vertex.
+// Pre: 1 <= u <= getOrder(G)
+int getNeighbors(Graph G, int u, const int **neighbors) {
+#ifndef NDEBUG
+    if (G == NULL) {
+        fprintf(stderr, "Graph Error: calling getNeighbors() on NULL Graph reference\n");
+        exit(EXIT_FAILURE);
+    }
+    if (u < 1 || u > getOrder(G) || neighbors == NULL) {
+        fprintf(stderr, "Graph Error: calling getNeighbors() with invalid vertex/vertices\n");
+        exit(EXIT_FAILURE);
+    }
+#endif
+    buildAdjacency(G);
+    *neighbors = G->adj + G->adj_offsets[u];
+    return G->adj_offsets[u + 1] - G->adj_offsets[u];
+}
+
+// Same as getNeighbors(), but for the in-neighbors of u, read from the reverse
+// index of G (built on the first call after G changes).
+// Pre: 1 <= u <= getOrder(G)
+int getInNeighbors(Graph G, int u, const int **neighbors) {
+#ifndef NDEBUG
+    if (G == NULL) {
+        fprintf(stderr, "Graph Error: calling getInNeighbors() on NULL Graph reference\n");
+        exit(EXIT_FAILURE);
+    }
+    if (u < 1 || u > getOrder(G) || neighbors == NULL) {
+        fprintf(stderr, "Graph Error: calling getInNeighbors() with invalid vertex/vertices\n");
+        exit(EXIT_FAILURE);
+    }
+#endif
+    buildAdjacency(G);
+    buildReverse(G);
+    *neighbors = G->radj + G->radj_offsets[u];
+    return G->radj_offsets[u + 1] - G->radj_offsets[u];
+}
+
+// Manipulation procedures ----------------------------------------------------
+
+// Adds an undirected edge between vertex u and v.
+// The vertex labels for each edge are maintained in sorted order.
+// Pre: 1 <= u <= getOrder(G)
+// Pre: 1 <= v <= getOrder(G)
+void addEdge(Graph G, int u, int v) {
+    if (G == NULL) {
+        fprintf(stderr, "Graph Error: calling addEdge() on NULL Graph reference\n");
+        exit(EXIT_FAILURE);
+    }
+    if (u < 1 || u > getOrder(G) || v < 1 || v > getOrder(G)) {
+        fprintf(stderr, "Graph Error: calling addEdge() with invalid vertex/vertices\n");
+        exit(EXIT_FAILURE);
+    }
+
+    stageArc(G, u, v);
+    stageArc(G, v, u);
+    G->size += 1;
+    return;
+}
+
+// Adds a directed edge from u to v.
+// The vertex labels for each edge are maintained in sorted order.
+// Pre: 1 <= u <= getOrder(G)
+// Pre: 1 <= v <= getOrder(G)
+void addArc(Graph G, int u, int v) {
+    if (G == NULL) {
+        fprintf(stderr, "Graph Error: calling addArc() on NULL Graph reference\n");
+        exit(EXIT_FAILURE);
+    }
+    if (u < 1 || u > getOrder(G) || v < 1 || v > getOrder(G)) {
+        fprintf(stderr, "Graph Error: calling addArc() with invalid vertex/vertices\n");
+        exit(EXIT_FAILURE);
+    }
+
+    stageArc(G, u, v);
+    G->size += 1;
+    return;
+}
+
+// Removes the undirected edge between vertex u and v (one copy of it, if the edge
+// was added more than once).
+// Pre: 1 <= u <= getOrder(G)
+// Pre: 1 <= v <= getOrder(G)
+// Pre: G contains the edge u - v
+void removeEdge(Graph G, int u, int v) {
+    if (G == NULL) {
+        fprintf(stderr, "Graph Error: calling removeEdge() on NULL Graph reference\n");
+        exit(EXIT_FAILURE);
+    }
+    if (u < 1 || u > getOrder(G) || v < 1 || v > getOrder(G)) {
+        fprintf(stderr, "Graph Error: calling removeEdge() with invalid vertex/vertices\n");
+        exit(EXIT_FAILURE);
+    }
+    // A self-loop edge is stored as two copies of the arc u -> u.
+    if ((u == v) ? countArc(G, u, u) < 2 : countArc(G, u, v) < 1 || countArc(G, v, u) < 1) {
+        fprintf(stderr, "Graph Error: calling removeEdge() on an edge that is not in G\n");
+        exit(EXIT_FAILURE);
+    }
+
+    stageRemoval(G, u, v);
+    stageRemoval(G, v, u);
+    G->size -= 1;
+    return;
+}
+
+// Removes the directed edge from u to v (one copy of it, if the arc was added
+// more than once). Removals are staged and applied together, in one pass over the
+// adjacency, the next time it is read.
+// Pre: 1 <= u <= getOrder(G)
+// Pre: 1 <= v <= getOrder(G)
+// Pre: G contains the arc u -> v
+void removeArc(Graph G, int u, int v) {
+    if (G == NULL) {
+        fprintf(stderr, "Graph Error: calling removeArc() on NULL Graph reference\n");
+        exit(EXIT_FAILURE);
+    }
+    if (u < 1 || u > getOrder(G) || v < 1 || v > getOrder(G)) {
+        fprintf(stderr, "Graph Error: calling removeArc() with invalid vertex/vertices\n");
+        exit(EXIT_FAILURE);
+    }
+    if (countArc(G, u, v) < 1) {
+        fprintf(stderr, "Graph Error: calling removeArc() on an arc that is not in G\n");
+        exit(EXIT_FAILURE);
+    }
+
+    stageRemoval(G, u, v);
+    G->size -= 1;
+    return;
+}
+
+// Performs DFS on the given graph G, pushing vertices onto the "stack" S.
+// Pre: length(S) == getOrder(G) (the order of the graph/number of vertices).
+void DFS(Graph G, List S) {
+    if (G == NULL) {
+        fprintf(stderr, "Graph Error: calling DFS() on NULL Graph reference\n");
+        exit(EXIT_FAILURE);
+    }
+    if (length(S) != getOrder(G)) {
+        fprintf(stderr, "Graph Error: calling DFS() with invalid stack\n");
+        exit(EXIT_FAILURE);
+    }
+
+    depthFirstList(G, S, true, false);
+    return;
+}
+
+// Performs the same DFS as DFS(G, S) and leaves S in the same finish order, but
+// does not record parents or discover/finish times; the state reported by
+// getParent(), getDiscover() and getFinish() is left unchanged. Use it when only
+// the finish order is needed, e.g. for the first pass of the two-DFS SCC method.
+// Pre: length(S) == getOrder(G) (the order of the graph/number of vertices).
+void DFSOrder(Graph G, List S) {
+    if (G == NULL) {
+        fprintf(stderr, "Graph Error: calling DFSOrder() on NULL Graph reference\n");
+        exit(EXIT_FAILURE);
+    }
+    if (length(S) != getOrder(G)) {
+        fprintf(stderr, "Graph Error: calling DFSOrder() with invalid stack\n");
+        exit(EXIT_FAILURE);
+    }
+
+    depthFirstList(G, S, false, false);
+    return;
+}
+
+// Array form of DFS(): starts new DFS trees at order[0], order[1], ..., order[n - 1]
+// and writes the vertices into finish_order[0 .. n - 1] in decreasing finish time
+// (the contents S would have after DFS(G, S)). Records parents and discover/finish
+// times like DFS(), but allocates no per-vertex List nodes. order and finish_order
+// must not overlap, and finish_order can be passed as the order of the next call.
+// Pre: order is a permutation of 1, 2, ..., getOrder(G)
+void DFSArray(Graph G, const int *order, int *finish_order) {
+    if (G == NULL) {
+        fprintf(stderr, "Graph Error: calling DFSArray() on NULL Graph reference\n");
+        exit(EXIT_FAILURE);
+    }
+    if (order == NULL || finish_order == NULL || order == finish_order) {
+        fprintf(stderr, "Graph Error: calling DFSArray() with invalid vertex arrays\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < getOrder(G); i += 1) {
+        if (order[i] < 1 || order[i] > getOrder(G)) {
+            fprintf(stderr, "Graph Error: calling DFSArray() with invalid vertex order\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    depthFirst(G, order, getOrder(G), finish_order, true, false);
+    return;
+}
+
+// Array form of DFSOrder(): like DFSArray(), but only produces finish_order and
+// leaves the state reported by getParent(), getDiscover() and getFinish() unchanged.
+// Pre: order is a permutation of 1, 2, ..., getOrder(G)
+void DFSOrderArray(Graph G, const int *order, int *finish_order) {
+    if (G == NULL) {
+        fprintf(stderr, "Graph Error: calling DFSOrderArray() on NULL Graph reference\n");
+        exit(EXIT_FAILURE);
+    }
+    if (order == NULL || finish_order == NULL || order == finish_order) {
+        fprintf(stderr, "Graph Error: calling DFSOrderArray() with invalid vertex arrays\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < getOrder(G); i += 1) {
+        if (order[i] < 1 || order[i] > getOrder(G)) {
+            fprintf(stderr, "Graph Error: calling DFSOrderArray() with invalid vertex order\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    depthFirst(G, order, getOrder(G), finish_order, false, false);
+    return;
+}
+
+// Performs DFS(G, S) on the transpose of G without building it: arcs are followed
+// backwards through a reverse adjacency index kept in G, which is built on the
+// first call and reused until G changes. Records parents and discover/finish times
+// in G, so getParent(G, u) reports the parents of the DFS over in-arcs.
+// Pre: length(S) == getOrder(G) (the order of the graph/number of vertices).
+void DFSReverse(Graph G, List S) {
+    if (G == NULL) {
+        fprintf(stderr, "Graph Error: calling DFSReverse() on NULL Graph reference\n");
+        exit(EXIT_FAILURE);
+    }
+    if (length(S) != getOrder(G)) {
+        fprintf(stderr, "Graph Error: calling DFSReverse() with invalid stack\n");
+        exit(EXIT_FAILURE);
+    }
+
+    depthFirstList(G, S, true, true);
+    return;
+}
+
+// Array form of DFSReverse(), with the same contract as DFSArray().
+// Pre: order is a permutation of 1, 2, ..., getOrder(G)
+void DFSReverseArray(Graph G, const int *order, int *finish_order) {
+    if (G == NULL) {
+        fprintf(stderr, "Graph Error: calling DFSReverseArray() on NULL Graph reference\n");
+        exit(EXIT_FAILURE);
+    }
+    if (order == NULL || finish_order == NULL || order == finish_order) {
+        fprintf(stderr, "Graph Error: calling DFSReverseArray() with invalid vertex arrays\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < getOrder(G); i += 1) {
+        if (order[i] < 1 || order[i] > getOrder(G)) {
+            fprintf(stderr, "Graph Error: calling DFSReverseArray() with invalid vertex order\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    depthFirst(G, order, getOrder(G), finish_order, true, true);
+    return;
+}
+
+// Performs DFS on G from root alone, which touches only the vertices reachable
+// from root: a new epoch of the DFS state stands in for resetting all n vertices.
+// Records parents and discover/finish times of the reached vertices; every other
+// vertex reads as parent NIL with undefined times. Writes the reached vertices in
+// decreasing finish time (root first) into finish_order and returns how many there
+// are.
+// Pre: 1 <= root <= getOrder(G), finish_order has room for getOrder(G) entries.
+int DFSFrom(Graph G, int root, int *finish_order) {
+    if (G == NULL) {
+        fprintf(stderr, "Graph Error: calling DFSFrom() on NULL Graph reference\n");
+        exit(EXIT_FAILURE);
+    }
+    if (root < 1 || root > getOrder(G) || finish_order == NULL) {
+        fprintf(stderr, "Graph Error: calling DFSFrom() with invalid vertex/vertices\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // visit() fills finish_order downwards from its end; the result is moved to the front.
+    int n = getOrder(G);
+    int top = n;
+    int time = 0;
+    buildAdjacency(G);
+    beginTraversal(G);
+    DFSFrame *stack = (DFSFrame *) malloc(n*sizeof(DFSFrame));
+    if (stack == NULL) {
+        fprintf(stderr, "Graph Error: out of memory in DFSFrom()\n");
+        exit(EXIT_FAILURE);
+    }
+    G->max_depth = visit(G, G->adj_offsets, G->adj, finish_order, &top, stack, root, &time);
+    G->visited = n - top;
+    memmove(finish_order, finish_order + top, (n - top)*sizeof(int));
+    free(stack);
+    return n - top;
+}
+
+// Performs BFS on G from source, touching only the vertices reachable from it.
+// Records the parent of every reached vertex in the BFS tree (source has parent
+// NIL); discover and finish times are left undefined, and every vertex not
+// reached reads as parent NIL. Writes the reached vertices in BFS order (source
+// first) into reached and returns how many there are. getMaxDepth() then reports
+// the number of BFS levels.
+// Pre: 1 <= source <= getOrder(G), reached has room for getOrder(G) entries.
+int BFSFrom(Graph G, int source, int *reached) {
+    if (G == NULL) {
+        fprintf(stderr, "Graph Error: calling BFSFrom() on NULL Graph reference\n");
+        exit(EXIT_FAILURE);
+    }
+    if (source < 1 || source > getOrder(G) || reached == NULL) {
+        fprintf(stderr, "Graph Error: calling BFSFrom() with invalid vertex/vertices\n");
+        exit(EXIT_FAILURE);
+    }
+
+    buildAdjacency(G);
+    beginTraversal(G);
+    VertexState *state = G->state;
+    int epoch = G->epoch;
+    state[source].parent = NIL;
+    state[source].discover = state[source].finish = UNDEF;
+    state[source].stamp = epoch;
+    reached[0] = source;
+    int tail = 1;
+    int levels = 0;
+    int level_end = 0;
+    for (int head = 0; head < tail; head += 1) {
+        if (head == level_end) {
+            levels += 1;
+            level_end = tail;
+        }
+        int v = reached[head];
+        for (int i = G->adj_offsets[v]; i < G->adj_offsets[v + 1]; i += 1) {
+            int w = G->adj[i];
+            if (state[w].stamp != epoch) {
+                state[w].parent = v;
+                state[w].discover = state[w].finish = UNDEF;
+                state[w].stamp = epoch;
+                reached[tail++] = w;
+            }
+        }
+    }
+    G->visited = tail;
+    G->max_depth = levels;
+    return tail;
+}
+
+// Finds the strongly connected components of G in a single depth-first pass
+// (Pearce's space-efficient variant of Tarjan's algorithm), writing the component
+// id of each vertex u into component[u] and returning the number of components.
+// Components are numbered 1, 2, ... in topological order of the component DAG,
+// matching the order produced by DFS(G), DFS(transpose(G)) with S = 1, 2, ..., n.
+// The DFS state reported by getParent(), getDiscover() and getFinish() is unchanged;
+// getVisited() and getMaxDepth() report the single pass.
+// Pre: component has room for getOrder(G) + 1 entries.
+int SCC(Graph G, int *component) {
+    if (G == NULL) {
+        fprintf(stderr, "Graph Error: calling SCC() on NULL Graph reference\n");
+        exit(EXIT_FAILURE);
+    }
+    if (component == NULL) {
+        fprintf(stderr, "Graph Error: calling SCC() with NULL component array\n");
+        exit(EXIT_FAILURE);
+    }
+
+    buildAdjacency(G);
+    return pearceComponents(G, component, NULL);
+}
+
+// Finds the strongly connected components of G using threads worker threads
+// (the number of online processors if threads < 1), writing the component id of
+// each vertex u into component[u] and returning the number of components.
+// The workers first trim vertices with no in- or out-neighbors among the remaining
+// vertices, then label the component of a high-degree pivot with a parallel
+// forward-backward search; the rest is finished by a single-threaded pass.
+// The partition matches SCC(); components are numbered 1, 2, ... in a topological
+// order of the component DAG, which need not be the order chosen by SCC().
+// getVisited() and getMaxDepth() report the single-threaded pass alone.
+// Pre: component has room for getOrder(G) + 1 entries.
+int parallelSCC(Graph G, int *component, int threads) {
+    if (G == NULL) {
+        fprintf(stderr, "Graph Error: calling parallelSCC() on NULL Graph reference\n");
+        exit(EXIT_FAILURE);
+    }
+    if (component == NULL) {
+        fprintf(stderr, "Graph Error: calling parallelSCC() with NULL component array\n");
+        exit(EXIT_FAILURE);
+    }
+
+    int n = getOrder(G);
+    if (threads < 1) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = (online > 0) ? (int) online : 1;
+    }
+    if (threads > n) {
+        threads = (n > 0) ? n : 1;
+    }
+
+    ParallelSCC P;
+    buildAdjacency(G);
+    buildReverse(G);
+    P.G = G;
+    P.component = component;
+    P.reach = (atomic_uchar *) malloc((n + 1)*sizeof(atomic_uchar));
+    P.frontier = (int *) malloc((n + 1)*sizeof(int));
+    P.next_frontier = (int *) malloc((n + 1)*sizeof(int));
+    P.best_vertex = (int *) malloc(threads*sizeof(int));
+    P.best_score = (long long *) malloc(threads*sizeof(long long));
+    pthread_t *handles = (pthread_t *) malloc(threads*sizeof(pthread_t));
+    SCCWorker *workers = (SCCWorker *) malloc(threads*sizeof(SCCWorker));
+    if (P.reach == NULL || P.frontier == NULL || P.next_frontier == NULL || P.best_vertex == NULL
+            || P.best_score == NULL || handles == NULL || workers == NULL) {
+        fprintf(stderr, "Graph Error: out of memory in parallelSCC()\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int v = 0; v < n + 1; v += 1) {
+        component[v] = 0;
+        atomic_init(&P.reach[v], 0);
+    }
+    P.frontier_size = 0;
+    atomic_init(&P.frontier_pos, 0);
+    atomic_init(&P.next_size, 0);
+    atomic_init(&P.next_label, 1);
+    atomic_init(&P.trimmed, 0);
+    P.pivot = 0;
+    P.pivot_label = 0;
+    P.threads = threads;
+    pthread_barrier_init(&P.barrier, NULL, threads);
+
+    for (int t = 0; t < threads; t += 1) {
+        workers[t].P = &P;
+        workers[t].id = t;
+        if (pthread_create(&handles[t], NULL, sccWorker, &workers[t]) != 0) {
+            fprintf(stderr, "Graph Error: unable to start threads in parallelSCC()\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    for (int t = 0; t < threads; t += 1) {
+        pthread_join(handles[t], NULL);
+    }
+    pthread_barrier_destroy(&P.barrier);
+
+    // Labels whatever the trimming and forward-backward phases left unassigned.
+    int count = atomic_load(&P.next_label) - 1;
+    int *rest = P.frontier;
+    count += pearceComponents(G, rest, component);
+    for (int v = 1; v < n + 1; v += 1) {
+        if (component[v] == 0) {
+            component[v] = atomic_load(&P.next_label) - 1 + rest[v];
+        }
+    }
+    numberTopologically(G, component, count);
+
+    free(P.reach);
+    free(P.frontier);
+    free(P.next_frontier);
+    free(P.best_vertex);
+    free(P.best_score);
+    free(handles);
+    free(workers);
+    return count;
+}
+
+// Peels off the vertices of G that are trivial strongly connected components:
+// repeatedly removes a vertex with no in-arcs or no out-arcs from the other
+// remaining vertices (self-loops are ignored), using in/out-degree counters so
+// the whole pass takes O(n + m) time. Vertices removed as sources are given the
+// ids 1, 2, ..., in removal order and vertices removed as sinks the ids
+// n, n - 1, ...; the remaining core vertices are left at 0. *sources is set to
+// the number of vertices removed as sources and the number of vertices removed is
+// returned. Numbering the core's components sources + 1, sources + 2, ... in
+// topological order and then closing the gap before the sink ids yields a
+// topological numbering of all components of G.
+// Pre: component has room for getOrder(G) + 1 entries.
+int trimGraph(Graph G, int *component, int *sources) {
+    if (G == NULL) {
+        fprintf(stderr, "Graph Error: calling trimGraph() on NULL Graph reference\n");
+        exit(EXIT_FAILURE);
+    }
+    if (component == NULL || sources == NULL) {
+        fprintf(stderr, "Graph Error: calling trimGraph() with NULL component array\n");
+        exit(EXIT_FAILURE);
+    }
+
+    buildAdjacency(G);
+    buildReverse(G);
+    int n = getOrder(G);
+    int *in_degree = (int *) calloc(n + 1, sizeof(int));
+    int *out_degree = (int *) calloc(n + 1, sizeof(int));
+    int *queue = (int *) malloc((n + 1)*sizeof(int));
+    bool *queued = (bool *) calloc(n + 1, sizeof(bool));
+    if (in_degree == NULL || out_degree == NULL || queue == NULL || queued == NULL) {
+        fprintf(stderr, "Graph Error: out of memory in trimGraph()\n");
+        exit(EXIT_FAILURE);
+    }
+
+    int head = 0;
+    int tail = 0;
+    for (int v = 1; v < n + 1; v += 1) {
+        component[v] = 0;
+        for (int i = G->adj_offsets[v]; i < G->adj_offsets[v + 1]; i += 1) {
+            if (G->adj[i] != v) {
+                out_degree[v] += 1;
+                in_degree[G->adj[i]] += 1;
+            }
+        }
+    }
+    for (int v = 1; v < n + 1; v += 1) {
+        if (in_degree[v] == 0 || out_degree[v] == 0) {
+            queue[tail++] = v;
+            queued[v] = true;
+        }
+    }
+
+    int source_count = 0;
+    int sink_count = 0;
+    while (head < tail) {
+        int v = queue[head++];
+        if (in_degree[v] == 0) {
+            // Removing a source only lowers the in-degrees of its out-neighbors.
+            source_count += 1;
+            component[v] = source_count;
+            for (int i = G->adj_offsets[v]; i < G->adj_offsets[v + 1]; i += 1) {
+                int w = G->adj[i];
+                if (w != v && component[w] == 0) {
+                    in_degree[w] -= 1;
+                    if (in_degree[w] == 0 && !queued[w]) {
+                        queue[tail++] = w;
+                        queued[w] = true;
+                    }
+                }
+            }
+        } else {
+            // Removing a sink only lowers the out-degrees of its in-neighbors.
+            component[v] = n - sink_count;
+            sink_count += 1;
+            for (int i = G->radj_offsets[v]; i < G->radj_offsets[v + 1]; i += 1) {
+                int w = G->radj[i];
+                if (w != v && component[w] == 0) {
+                    out_degree[w] -= 1;
+                    if (out_degree[w] == 0 && !queued[w]) {
+                        queue[tail++] = w;
+                        queued[w] = true;
+                    }
+                }
+            }
+        }
+    }
+
+    free(in_degree);
+    free(out_degree);
+    free(queue);
+    free(queued);
+    *sources = source_count;
+    return source_count + sink_count;
+}
+
+// Other operations ------------------------------------------------------------
+
+// Returns a new transpose graph of a graph G, copied from the reverse index if G
+// already has one and built by reverseArcs() otherwise.
+Graph transpose(Graph G) {
+    if (G == NULL) {
+        fprintf(stderr, "Graph Error: calling transpose() on NULL Graph reference\n");
+        exit(EXIT_FAILURE);
+    }
+    
+    buildAdjacency(G);
+    int n = getOrder(G);
+    int arcs = G->adj_offsets[n + 1];
+    Graph transpose = newGraph(n);
+    free(transpose->adj);
+    transpose->adj = (int *) malloc((arcs > 0 ? arcs : 1)*sizeof(int));
+    if (G->radj_offsets != NULL) {
+        memcpy(transpose->adj_offsets, G->radj_offsets, (n + 2)*sizeof(int));
+        memcpy(transpose->adj, G->radj, arcs*sizeof(int));
+    } else {
+        reverseArcs(G, transpose->adj_offsets, transpose->adj);
+    }
+    transpose->size = G->size;
+    return transpose;
+}
+
+// Returns a new copy of graph G.
+Graph copyGraph(Graph G) {
+    if (G == NULL) {
+        fprintf(stderr, "Graph Error: calling copyGraph() on NULL Graph reference\n");
+        exit(EXIT_FAILURE);
+    }
+
+    buildAdjacency(G);
+    int n = getOrder(G);
+    int arcs = G->adj_offsets[n + 1];
+    Graph copy = newGraph(n);
+    free(copy->adj);
+    copy->adj = (int *) malloc((arcs > 0 ? arcs : 1)*sizeof(int));
+
+    memcpy(copy->adj_offsets, G->adj_offsets, (n + 2)*sizeof(int));
+    memcpy(copy->adj, G->adj, arcs*sizeof(int));
+    copy->size = G->size;
+    return copy;
+}
+
+// Returns the subgraph of G induced by the vertices v with exclude[v] == 0,
+// relabelled 1, 2, ... in increasing order of their labels in G. If vertex_of is
+// not NULL, vertex_of[i] is set to the vertex of G that became vertex i.
+// Pre: vertex_of, if not NULL, has room for getOrder(G) + 1 entries.
+Graph inducedSubgraph(Graph G, const int *exclude, int *vertex_of) {
+    if (G == NULL) {
+        fprintf(stderr, "Graph Error: calling inducedSubgraph() on NULL Graph reference\n");
+        exit(EXIT_FAILURE);
+    }
+    if (exclude == NULL) {
+        fprintf(stderr, "Graph Error: calling inducedSubgraph() with NULL exclude array\n");
+        exit(EXIT_FAILURE);
+    }
+
+    buildAdjacency(G);
+    int n = getOrder(G);
+    int *label = (int *) calloc(n + 1, sizeof(int));
+    if (label == NULL) {
+        fprintf(stderr, "Graph Error: out of memory in inducedSubgraph()\n");
+        exit(EXIT_FAILURE);
+    }
+    int k = 0;
+    int arcs = 0;
+    for (int v = 1; v < n + 1; v += 1) {
+        if (exclude[v] == 0) {
+            k += 1;
+            label[v] = k;
+            if (vertex_of != NULL) {
+                vertex_of[k] = v;
+            }
+        }
+    }
+    for (int v = 1; v < n + 1; v += 1) {
+        for (int i = G->adj_offsets[v]; label[v] != 0 && i < G->adj_offsets[v + 1]; i += 1) {
+            if (label[G->adj[i]] != 0) {
+                arcs += 1;
+            }
+        }
+    }
+
+    // Relabelling preserves vertex order, so every row of the subgraph stays sorted.
+    Graph H = newGraph(k);
+    free(H->adj);
+    H->adj = (int *) malloc((arcs > 0 ? arcs : 1)*sizeof(int));
+    int j = 0;
+    for (int v = 1; v < n + 1; v += 1) {
+        if (label[v] == 0) {
+            continue;
+        }
+        for (int i = G->adj_offsets[v]; i < G->adj_offsets[v + 1]; i += 1) {
+            if (label[G->adj[i]] != 0) {
+                H->adj[j++] = label[G->adj[i]];
+            }
+        }
+        H->adj_offsets[label[v] + 1] = j;
+    }
+    H->size = arcs;
+    free(label);
+    return H;
+}
+
+// Returns the condensation of G: the graph with one vertex per strongly connected
+// component, given by component[1..n] with ids 1..count, and one arc c -> d for
+// every pair of distinct components joined by at least one arc of G. If sizes is
+// not NULL, sizes[c] is set to the number of vertices in component c. Runs in
+// O(n + m) time; the component ids may come from SCC(), parallelSCC() or the
+// DFS(G), DFS(transpose(G)) forest.
+// Pre: 1 <= component[u] <= count, sizes (if not NULL) has room for count + 1 entries.
+Graph condensation(Graph G, const int *component, int count, int *sizes) {
+    if (G == NULL) {
+        fprintf(stderr, "Graph Error: calling condensation() on NULL Graph reference\n");
+        exit(EXIT_FAILURE);
+    }
+    if (component == NULL || count < 0) {
+        fprintf(stderr, "Graph Error: calling condensation() with invalid component array\n");
+        exit(EXIT_FAILURE);
+    }
+
+    buildAdjacency(G);
+    int n = getOrder(G);
+    int *offsets = (int *) calloc(count + 2, sizeof(int));
+    int *members = (int *) malloc((n > 0 ? n : 1)*sizeof(int));
+    int *last_source = (int *) calloc(count + 1, sizeof(int));
+    if (offsets == NULL || members == NULL || last_source == NULL) {
+        fprintf(stderr, "Graph Error: out of memory in condensation()\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int v = 1; v < n + 1; v += 1) {
+        if (component[v] < 1 || component[v] > count) {
+            fprintf(stderr, "Graph Error: calling condensation() with invalid component array\n");
+            exit(EXIT_FAILURE);
+        }
+        offsets[component[v] + 1] += 1;
+    }
+    if (sizes != NULL) {
+        for (int c = 1; c < count + 1; c += 1) {
+            sizes[c] = offsets[c + 1];
+        }
+    }
+    for (int c = 1; c < count + 1; c += 1) {
+        offsets[c + 1] += offsets[c];
+    }
+    for (int v = 1; v < n + 1; v += 1) {
+        members[offsets[component[v]]] = v;
+        offsets[component[v]] += 1;
+    }
+
+    // Walks the components one at a time; last_source[d] == c marks that the arc
+    // c -> d was already recorded, which removes duplicates without sorting.
+    int arcs = 0;
+    int capacity = 16;
+    int *src = (int *) malloc(capacity*sizeof(int));
+    int *dst = (int *) malloc(capacity*sizeof(int));
+    int start = 0;
+    for (int c = 1; c < count + 1; c += 1) {
+        for (int k = start; k < offsets[c]; k += 1) {
+            int v = members[k];
+            for (int i = G->adj_offsets[v]; i < G->adj_offsets[v + 1]; i += 1) {
+                int d = component[G->adj[i]];
+                if (d == c || last_source[d] == c) {
+                    continue;
+                }
+                last_source[d] = c;
+                if (arcs == capacity) {
+                    capacity *= 2;
+                    src = (int *) realloc(src, capacity*sizeof(int));
+                    dst = (int *) realloc(dst, capacity*sizeof(int));
+                    if (src == NULL || dst == NULL) {
+                        fprintf(stderr, "Graph Error: out of memory in condensation()\n");
+                        exit(EXIT_FAILURE);
+                    }
+                }
+                src[arcs] = c;
+                dst[arcs] = d;
+                arcs += 1;
+            }
+        }
+        start = offsets[c];
+    }
+
+    Graph C = newGraphFromEdges(count, src, dst, arcs);
+    free(offsets);
+    free(members);
+    free(last_source);
+    free(src);
+    free(dst);
+    return C;
+}
+
+// Prints the Graph G to out.
+void printGraph(FILE* out, Graph G) {
+    if (G == NULL) {
         fprintf(stderr, "Graph Error: calling printGraph() on NULL Graph reference\n");
         exit(EXIT_FAILURE);
     }
-    
-    for (int i = 1; i < getOrder(G) + 1; i += 1) {
-        fprintf(out, "%d: ", i);
-        printList(out, G->list_array[i]);
-        fprintf(out, "\n");
+
+    buildAdjacency(G);
+    for (int i = 1; i < getOrder(G) + 1; i += 1) {
+        fprintf(out, "%d: ", i);
+        for (int j = G->adj_offsets[i]; j < G->adj_offsets[i + 1]; j += 1) {
+            fprintf(out, "%d ", G->adj[j]);
+        }
+        fprintf(out, "\n");
+    }
+    return;
+}
+
+// Same as printGraph(), but appends to the buffered Writer W.
+void writeGraph(Writer W, Graph G) {
+    if (G == NULL) {
+        fprintf(stderr, "Graph Error: calling writeGraph() on NULL Graph reference\n");
+        exit(EXIT_FAILURE);
+    }
+    
+    buildAdjacency(G);
+    for (int i = 1; i < getOrder(G) + 1; i += 1) {
+        writeInt(W, i);
+        writeString(W, ": ");
+        for (int j = G->adj_offsets[i]; j < G->adj_offsets[i + 1]; j += 1) {
+            writeInt(W, G->adj[j]);
+            writeChar(W, ' ');
+        }
+        writeChar(W, '\n');
+    }
+    return;
+}
+
+// Writes G to the file at path in the binary graph format read by loadGraph().
+void saveGraph(Graph G, const char *path) {
+    if (G == NULL) {
+        fprintf(stderr, "Graph Error: calling saveGraph() on NULL Graph reference\n");
+        exit(EXIT_FAILURE);
+    }
+    if (path == NULL) {
+        fprintf(stderr, "Graph Error: calling saveGraph() with NULL path\n");
+        exit(EXIT_FAILURE);
+    }
+
+    buildAdjacency(G);
+    int n = getOrder(G);
+    GraphFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, GRAPH_FILE_MAGIC, sizeof(header.magic));
+    header.version = GRAPH_FILE_VERSION;
+    header.order = n;
+    header.arcs = G->adj_offsets[n + 1];
+    header.size = G->size;
+    header.checksum = checksumWords(G->adj_offsets, (size_t) n + 2, 0);
+    header.checksum = checksumWords(G->adj, (size_t) header.arcs, header.checksum);
+
+    FILE *out = fopen(path, "wb");
+    if (out == NULL) {
+        fprintf(stderr, "Unable to open file %s for writing\n", path);
+        exit(EXIT_FAILURE);
+    }
+    if (fwrite(&header, sizeof(header), 1, out) != 1
+            || fwrite(G->adj_offsets, sizeof(int), (size_t) n + 2, out) != (size_t) n + 2
+            || fwrite(G->adj, sizeof(int), (size_t) header.arcs, out) != (size_t) header.arcs
+            || fclose(out) != 0) {
+        fprintf(stderr, "Unable to write file %s\n", path);
+        exit(EXIT_FAILURE);
+    }
+    return;
+}
+
+// Returns the Graph stored at path by saveGraph(). The CSR arrays are used in place
+// from a read-only memory mapping of the file rather than copied; they are only
+// copied to the heap if arcs are later added to the Graph.
+// Exits with an error if the file is truncated, corrupt or not a graph file.
+Graph loadGraph(const char *path) {
+    if (path == NULL) {
+        fprintf(stderr, "Graph Error: calling loadGraph() with NULL path\n");
+        exit(EXIT_FAILURE);
+    }
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Unable to open file %s for reading\n", path);
+        exit(EXIT_FAILURE);
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < (off_t) sizeof(GraphFileHeader)) {
+        fprintf(stderr, "Graph Error: %s is not a binary graph file\n", path);
+        exit(EXIT_FAILURE);
+    }
+    size_t length = (size_t) info.st_size;
+    void *mapping = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        fprintf(stderr, "Graph Error: unable to map %s\n", path);
+        exit(EXIT_FAILURE);
+    }
+
+    const GraphFileHeader *header = (const GraphFileHeader *) mapping;
+    if (memcmp(header->magic, GRAPH_FILE_MAGIC, sizeof(header->magic)) != 0
+            || header->version != GRAPH_FILE_VERSION) {
+        fprintf(stderr, "Graph Error: %s is not a binary graph file\n", path);
+        exit(EXIT_FAILURE);
+    }
+    int n = header->order;
+    int64_t arcs = header->arcs;
+    if (n < 0 || arcs < 0 || arcs > INT32_MAX
+            || length != sizeof(GraphFileHeader) + ((size_t) n + 2 + (size_t) arcs)*sizeof(int)) {
+        fprintf(stderr, "Graph Error: %s is truncated or has an invalid header\n", path);
+        exit(EXIT_FAILURE);
+    }
+
+    int *offsets = (int *) ((char *) mapping + sizeof(GraphFileHeader));
+    int *adj = offsets + n + 2;
+    uint64_t checksum = checksumWords(offsets, (size_t) n + 2, 0);
+    checksum = checksumWords(adj, (size_t) arcs, checksum);
+    if (checksum != header->checksum) {
+        fprintf(stderr, "Graph Error: checksum mismatch in %s\n", path);
+        exit(EXIT_FAILURE);
+    }
+    // The rest of Graph.c relies on every row being sorted (countArc() searches it and
+    // buildAdjacency() merges into it); parallel arcs leave equal neighbors side by side.
+    bool valid = offsets[0] == 0 && offsets[1] == 0 && offsets[n + 1] == arcs
+            && header->size >= 0 && header->size <= arcs && header->size <= INT_MAX;
+    for (int u = 1; valid && u < n + 1; u += 1) {
+        valid = offsets[u] <= offsets[u + 1];
+    }
+    for (int u = 1; valid && u < n + 1; u += 1) {
+        for (int i = offsets[u]; valid && i < offsets[u + 1]; i += 1) {
+            valid = adj[i] >= 1 && adj[i] <= n && (i == offsets[u] || adj[i - 1] <= adj[i]);
+        }
+    }
+    if (!valid) {
+        fprintf(stderr, "Graph Error: %s contains an invalid adjacency structure\n", path);
+        exit(EXIT_FAILURE);
+    }
+
+    Graph G = newGraph(n);
+    free(G->adj_offsets);
+    free(G->adj);
+    G->adj_offsets = offsets;
+    G->adj = adj;
+    G->mapping = mapping;
+    G->mapping_length = length;
+    G->size = (int) header->size;
+    return G;
+}
+
+// Read-only views -------------------------------------------------------------
+
+// Returns a read-only view of G for concurrent queries. Builds the adjacency and
+// the reverse index of G up front, so no later read has to change anything.
+// The view borrows G's arrays: G must not be changed or freed while it is in use.
+GraphView newGraphView(Graph G) {
+    if (G == NULL) {
+        fprintf(stderr, "Graph Error: calling newGraphView() on NULL Graph reference\n");
+        exit(EXIT_FAILURE);
+    }
+
+    buildAdjacency(G);
+    buildReverse(G);
+    GraphViewObj *V = malloc(sizeof(GraphViewObj));
+    if (V == NULL) {
+        fprintf(stderr, "Graph Error: out of memory in newGraphView()\n");
+        exit(EXIT_FAILURE);
+    }
+    V->adj_offsets = G->adj_offsets;
+    V->adj = G->adj;
+    V->radj_offsets = G->radj_offsets;
+    V->radj = G->radj;
+    V->order = G->order;
+    V->size = G->size;
+    return V;
+}
+
+// Frees the view *pV (but not its Graph) and sets *pV to NULL.
+void freeGraphView(GraphView *pV) {
+    if (pV != NULL && *pV != NULL) {
+        free((GraphViewObj *) *pV);
+        *pV = NULL;
+    }
+    return;
+}
+
+// Returns the order of the Graph seen by V.
+int getViewOrder(GraphView V) {
+    if (V == NULL) {
+        fprintf(stderr, "Graph Error: calling getViewOrder() on NULL GraphView reference\n");
+        exit(EXIT_FAILURE);
+    }
+    return V->order;
+}
+
+// Returns the size of the Graph seen by V.
+int getViewSize(GraphView V) {
+    if (V == NULL) {
+        fprintf(stderr, "Graph Error: calling getViewSize() on NULL GraphView reference\n");
+        exit(EXIT_FAILURE);
+    }
+    return V->size;
+}
+
+// Same as getNeighbors(), for a view: sets *neighbors to the sorted out-neighbors
+// of u and returns how many there are.
+// Pre: 1 <= u <= getViewOrder(V)
+int getViewNeighbors(GraphView V, int u, const int **neighbors) {
+#ifndef NDEBUG
+    if (V == NULL) {
+        fprintf(stderr, "Graph Error: calling getViewNeighbors() on NULL GraphView reference\n");
+        exit(EXIT_FAILURE);
+    }
+    if (u < 1 || u > V->order || neighbors == NULL) {
+        fprintf(stderr, "Graph Error: calling getViewNeighbors() with invalid vertex/vertices\n");
+        exit(EXIT_FAILURE);
+    }
+#endif
+    *neighbors = V->adj + V->adj_offsets[u];
+    return V->adj_offsets[u + 1] - V->adj_offsets[u];
+}
+
+// Same as getInNeighbors(), for a view.
+// Pre: 1 <= u <= getViewOrder(V)
+int getViewInNeighbors(GraphView V, int u, const int **neighbors) {
+#ifndef NDEBUG
+    if (V == NULL) {
+        fprintf(stderr, "Graph Error: calling getViewInNeighbors() on NULL GraphView reference\n");
+        exit(EXIT_FAILURE);
+    }
+    if (u < 1 || u > V->order || neighbors == NULL) {
+        fprintf(stderr, "Graph Error: calling getViewInNeighbors() with invalid vertex/vertices\n");
+        exit(EXIT_FAILURE);
+    }
+#endif
+    *neighbors = V->radj + V->radj_offsets[u];
+    return V->radj_offsets[u + 1] - V->radj_offsets[u];
+}
+
+// Returns the state for running searches over V from one thread. Threads sharing
+// V each need their own ViewSearch.
+ViewSearch newViewSearch(GraphView V) {
+    if (V == NULL) {
+        fprintf(stderr, "Graph Error: calling newViewSearch() on NULL GraphView reference\n");
+        exit(EXIT_FAILURE);
+    }
+
+    int n = V->order;
+    ViewSearch S = malloc(sizeof(ViewSearchObj));
+    if (S != NULL) {
+        S->stamp = (int *) calloc(n + 1, sizeof(int));
+        S->order = (int *) malloc((n > 0 ? n : 1)*sizeof(int));
+        S->stack = (DFSFrame *) malloc((n > 0 ? n : 1)*sizeof(DFSFrame));
+    }
+    if (S == NULL || S->stamp == NULL || S->order == NULL || S->stack == NULL) {
+        fprintf(stderr, "Graph Error: out of memory in newViewSearch()\n");
+        exit(EXIT_FAILURE);
+    }
+    S->V = V;
+    S->epoch = 0;
+    S->seen = S->visit = S->next = NULL;
+    S->frontier = S->next_frontier = S->reached = NULL;
+    S->reached_count = 0;
+    return S;
+}
+
+// Frees the search state *pS and sets *pS to NULL.
+void freeViewSearch(ViewSearch *pS) {
+    if (pS != NULL && *pS != NULL) {
+        free((*pS)->stamp);
+        free((*pS)->order);
+        free((*pS)->stack);
+        free((*pS)->seen);
+        free((*pS)->visit);
+        free((*pS)->next);
+        free((*pS)->frontier);
+        free((*pS)->next_frontier);
+        free((*pS)->reached);
+        free(*pS);
+        *pS = NULL;
+    }
+    return;
+}
+
+// Breadth-first search over S->V from source, following in-arcs instead of
+// out-arcs if reverse is true. Sets *reached to the vertices reached (source
+// first, then in BFS order) and returns how many there are; the array belongs to
+// S and is overwritten by its next search. Takes time proportional to the part
+// of the graph reached, with nothing to reset before or after.
+int viewBFS(ViewSearch S, int source, bool reverse, const int **reached) {
+    checkSearch(S, source, "viewBFS");
+    if (reached == NULL) {
+        fprintf(stderr, "Graph Error: calling viewBFS() with NULL result reference\n");
+        exit(EXIT_FAILURE);
+    }
+
+    GraphView V = S->V;
+    const int *offsets = reverse ? V->radj_offsets : V->adj_offsets;
+    const int *adj = reverse ? V->radj : V->adj;
+    int tail = 0;
+    nextEpoch(S);
+    S->stamp[source] = S->epoch;
+    S->order[tail++] = source;
+    for (int head = 0; head < tail; head += 1) {
+        int v = S->order[head];
+        for (int i = offsets[v]; i < offsets[v + 1]; i += 1) {
+            int w = adj[i];
+            if (S->stamp[w] != S->epoch) {
+                S->stamp[w] = S->epoch;
+                S->order[tail++] = w;
+            }
+        }
+    }
+    *reached = S->order;
+    return tail;
+}
+
+// Depth-first search over S->V from root, following in-arcs instead of out-arcs
+// if reverse is true, with neighbors taken in increasing order. Sets *finished to
+// the vertices reached in decreasing finish time (root first) and returns how
+// many there are; the array belongs to S and is overwritten by its next search.
+int viewDFS(ViewSearch S, int root, bool reverse, const int **finished) {
+    checkSearch(S, root, "viewDFS");
+    if (finished == NULL) {
+        fprintf(stderr, "Graph Error: calling viewDFS() with NULL result reference\n");
+        exit(EXIT_FAILURE);
+    }
+
+    GraphView V = S->V;
+    const int *offsets = reverse ? V->radj_offsets : V->adj_offsets;
+    const int *adj = reverse ? V->radj : V->adj;
+    int count = 0;
+    int depth = 0;
+    nextEpoch(S);
+    S->stamp[root] = S->epoch;
+    S->stack[0].vertex = root;
+    S->stack[0].next = offsets[root];
+    while (depth >= 0) {
+        DFSFrame *frame = &S->stack[depth];
+        int v = frame->vertex;
+        while (frame->next < offsets[v + 1] && S->stamp[adj[frame->next]] == S->epoch) {
+            frame->next += 1;
+        }
+        if (frame->next < offsets[v + 1]) {
+            int w = adj[frame->next];
+            frame->next += 1;
+            S->stamp[w] = S->epoch;
+            depth += 1;
+            S->stack[depth].vertex = w;
+            S->stack[depth].next = offsets[w];
+        } else {
+            S->order[count++] = v;
+            depth -= 1;
+        }
+    }
+
+    // Turns the finish order around.
+    for (int i = 0, j = count - 1; i < j; i += 1, j -= 1) {
+        int swap = S->order[i];
+        S->order[i] = S->order[j];
+        S->order[j] = swap;
+    }
+    *finished = S->order;
+    return count;
+}
+
+// Returns true if there is a path from u to v in S->V (every vertex reaches
+// itself). Searches breadth-first from u and stops as soon as v is found.
+bool viewReaches(ViewSearch S, int u, int v) {
+    checkSearch(S, u, "viewReaches");
+    checkSearch(S, v, "viewReaches");
+
+    GraphView V = S->V;
+    bool found = (u == v);
+    int tail = 0;
+    nextEpoch(S);
+    S->stamp[u] = S->epoch;
+    S->order[tail++] = u;
+    for (int head = 0; head < tail && !found; head += 1) {
+        int x = S->order[head];
+        for (int i = V->adj_offsets[x]; i < V->adj_offsets[x + 1]; i += 1) {
+            int w = V->adj[i];
+            if (w == v) {
+                found = true;
+                break;
+            }
+            if (S->stamp[w] != S->epoch) {
+                S->stamp[w] = S->epoch;
+                S->order[tail++] = w;
+            }
+        }
+    }
+    return found;
+}
+
+// Finds which of the k <= 64 vertices sources[0 .. k - 1] reach which vertices of
+// S->V (following in-arcs instead if reverse is true) with one bit-parallel BFS:
+// bit i of a vertex's mask stands for sources[i], and a level of the search moves
+// all the bits that reached a vertex across each of its arcs at once. Sets *masks
+// to the per-vertex masks ((*masks)[v] has bit i set iff sources[i] reaches v, and
+// is 0 for vertices reached by no source) and *reached to the vertices reached by
+// any source, and returns how many there are. If counts is not NULL, counts[i] is
+// set to the number of vertices sources[i] reaches. Both arrays belong to S and
+// are overwritten by its next batch; clearing them costs only what the last
+// batch reached, never O(n).
+// Pre: 1 <= k <= 64, 1 <= sources[i] <= getViewOrder(S->V)
+int viewReachBatch(ViewSearch S, const int *sources, int k, bool reverse,
+                   const uint64_t **masks, const int **reached, int *counts) {
+    if (S == NULL) {
+        fprintf(stderr, "Graph Error: calling viewReachBatch() on NULL ViewSearch reference\n");
+        exit(EXIT_FAILURE);
+    }
+    if (sources == NULL || k < 1 || k > 64 || masks == NULL || reached == NULL) {
+        fprintf(stderr, "Graph Error: calling viewReachBatch() with invalid source batch\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < k; i += 1) {
+        checkSearch(S, sources[i], "viewReachBatch");
+    }
+
+    GraphView V = S->V;
+    int n = V->order;
+    if (S->seen == NULL) {
+        S->seen = (uint64_t *) calloc(n + 1, sizeof(uint64_t));
+        S->visit = (uint64_t *) calloc(n + 1, sizeof(uint64_t));
+        S->next = (uint64_t *) calloc(n + 1, sizeof(uint64_t));
+        S->frontier = (int *) malloc(n*sizeof(int));
+        S->next_frontier = (int *) malloc(n*sizeof(int));
+        S->reached = (int *) malloc(n*sizeof(int));
+        if (S->seen == NULL || S->visit == NULL || S->next == NULL || S->frontier == NULL
+                || S->next_frontier == NULL || S->reached == NULL) {
+            fprintf(stderr, "Graph Error: out of memory in viewReachBatch()\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    for (int i = 0; i < S->reached_count; i += 1) {
+        S->seen[S->reached[i]] = 0;
+    }
+
+    const int *offsets = reverse ? V->radj_offsets : V->adj_offsets;
+    const int *adj = reverse ? V->radj : V->adj;
+    int count = 0;
+    int size = 0;
+    for (int i = 0; i < k; i += 1) {
+        int s = sources[i];
+        if (S->seen[s] == 0) {
+            S->reached[count++] = s;
+            S->frontier[size++] = s;
+        }
+        S->seen[s] |= (uint64_t) 1 << i;
+        S->visit[s] = S->seen[s];
+    }
+
+    while (size > 0) {
+        int next_size = 0;
+        for (int j = 0; j < size; j += 1) {
+            int v = S->frontier[j];
+            uint64_t bits = S->visit[v];
+            S->visit[v] = 0;
+            for (int i = offsets[v]; i < offsets[v + 1]; i += 1) {
+                int w = adj[i];
+                uint64_t fresh = bits & ~S->seen[w];
+                if (fresh == 0) {
+                    continue;
+                }
+                if (S->seen[w] == 0) {
+                    S->reached[count++] = w;
+                }
+                if (S->next[w] == 0) {
+                    S->next_frontier[next_size++] = w;
+                }
+                S->seen[w] |= fresh;
+                S->next[w] |= fresh;
+            }
+        }
+
+        // The next level's bits become the ones to move on.
+        for (int j = 0; j < next_size; j += 1) {
+            int w = S->next_frontier[j];
+            S->visit[w] = S->next[w];
+            S->next[w] = 0;
+        }
+        int *swap = S->frontier;
+        S->frontier = S->next_frontier;
+        S->next_frontier = swap;
+        size = next_size;
+    }
+
+    if (counts != NULL) {
+        for (int i = 0; i < k; i += 1) {
+            counts[i] = 0;
+        }
+        for (int j = 0; j < count; j += 1) {
+            for (uint64_t bits = S->seen[S->reached[j]]; bits != 0; bits &= bits - 1) {
+                counts[__builtin_ctzll(bits)] += 1;
+            }
+        }
+    }
+    S->reached_count = count;
+    *masks = S->seen;
+    *reached = S->reached;
+    return count;
+}
+
+// Reachability index ----------------------------------------------------------
+
+// Returns a reachability index for G, whose SCC's are given by component[1..n],
+// numbered 1..count in topological order as SCC() returns them. Builds the
+// condensation of G, its topological levels, and either its full transitive
+// closure (up to CLOSURE_LIMIT components) or REACH_LABELS interval labellings.
+// The index keeps its own copy of everything it needs, so G may change or be
+// freed afterwards, but the index then still describes G as it was.
+ReachIndex newReachIndex(Graph G, const int *component, int count) {
+    if (G == NULL) {
+        fprintf(stderr, "Graph Error: calling newReachIndex() on NULL Graph reference\n");
+        exit(EXIT_FAILURE);
+    }
+    if (component == NULL || count < 0) {
+        fprintf(stderr, "Graph Error: calling newReachIndex() with invalid component array\n");
+        exit(EXIT_FAILURE);
+    }
+
+    int n = getOrder(G);
+    ReachIndex R = malloc(sizeof(ReachIndexObj));
+    if (R == NULL) {
+        fprintf(stderr, "Graph Error: out of memory in newReachIndex()\n");
+        exit(EXIT_FAILURE);
+    }
+    R->C = condensation(G, component, count, NULL);
+    R->order = n;
+    R->count = count;
+    R->component = (int *) malloc((n + 1)*sizeof(int));
+    R->level = (int *) calloc(count + 1, sizeof(int));
+    R->stamp = (int *) calloc(count + 1, sizeof(int));
+    R->stack = (int *) malloc((count > 0 ? count : 1)*sizeof(int));
+    if (R->component == NULL || R->level == NULL || R->stamp == NULL || R->stack == NULL) {
+        fprintf(stderr, "Graph Error: out of memory in newReachIndex()\n");
+        exit(EXIT_FAILURE);
+    }
+    memcpy(R->component, component, (n + 1)*sizeof(int));
+    R->epoch = 0;
+
+    // Every arc of the condensation must go forward in the numbering; the levels
+    // then follow in one pass in that order.
+    Graph C = R->C;
+    for (int c = 1; c < count + 1; c += 1) {
+        for (int i = C->adj_offsets[c]; i < C->adj_offsets[c + 1]; i += 1) {
+            int d = C->adj[i];
+            if (d < c) {
+                fprintf(stderr, "Graph Error: calling newReachIndex() with components not in topological order\n");
+                exit(EXIT_FAILURE);
+            }
+            if (R->level[d] < R->level[c] + 1) {
+                R->level[d] = R->level[c] + 1;
+            }
+        }
+    }
+
+    R->closure = NULL;
+    R->rank = R->low = NULL;
+    R->words = 0;
+    if (count <= CLOSURE_LIMIT) {
+        // Row c is c itself plus the rows of its successors, which all come later.
+        R->words = (count + 64)/64;
+        R->closure = (uint64_t *) calloc((size_t) (count + 1)*R->words, sizeof(uint64_t));
+        if (R->closure == NULL) {
+            fprintf(stderr, "Graph Error: out of memory in newReachIndex()\n");
+            exit(EXIT_FAILURE);
+        }
+        for (int c = count; c >= 1; c -= 1) {
+            uint64_t *row = R->closure + (size_t) c*R->words;
+            row[c/64] |= (uint64_t) 1 << (c % 64);
+            for (int i = C->adj_offsets[c]; i < C->adj_offsets[c + 1]; i += 1) {
+                const uint64_t *next = R->closure + (size_t) C->adj[i]*R->words;
+                for (int w = c/64; w < R->words; w += 1) {
+                    row[w] |= next[w];
+                }
+            }
+        }
+    } else {
+        R->rank = (int *) malloc((size_t) REACH_LABELS*(count + 1)*sizeof(int));
+        R->low = (int *) malloc((size_t) REACH_LABELS*(count + 1)*sizeof(int));
+        if (R->rank == NULL || R->low == NULL) {
+            fprintf(stderr, "Graph Error: out of memory in newReachIndex()\n");
+            exit(EXIT_FAILURE);
+        }
+        for (int l = 0; l < REACH_LABELS; l += 1) {
+            labelComponents(R, R->rank + (size_t) l*(count + 1), R->low + (size_t) l*(count + 1),
+                            0x9E3779B97F4A7C15ULL*(l + 1));
+        }
+    }
+    return R;
+}
+
+// Frees all heap memory associated with *pR, and sets *pR to NULL.
+void freeReachIndex(ReachIndex *pR) {
+    if (pR != NULL && *pR != NULL) {
+        freeGraph(&(*pR)->C);
+        free((*pR)->component);
+        free((*pR)->level);
+        free((*pR)->rank);
+        free((*pR)->low);
+        free((*pR)->closure);
+        free((*pR)->stamp);
+        free((*pR)->stack);
+        free(*pR);
+        *pR = NULL;
+    }
+    return;
+}
+
+// Returns true if there is a path from u to v in the Graph R was built from
+// (every vertex reaches itself). With the transitive closure this is one bit
+// test; otherwise the levels and interval labels settle most queries at once and
+// the rest run a search of the condensation that they prune. Queries that need
+// the search use scratch state in R, so they must not run concurrently on one R.
+// Pre: 1 <= u, v <= the order of that Graph
+bool isReachable(ReachIndex R, int u, int v) {
+    if (R == NULL) {
+        fprintf(stderr, "Graph Error: calling isReachable() on NULL ReachIndex reference\n");
+        exit(EXIT_FAILURE);
+    }
+    if (u < 1 || u > R->order || v < 1 || v > R->order) {
+        fprintf(stderr, "Graph Error: calling isReachable() with invalid vertex/vertices\n");
+        exit(EXIT_FAILURE);
+    }
+
+    int c = R->component[u];
+    int d = R->component[v];
+    if (c == d) {
+        return true;
+    }
+    if (R->closure != NULL) {
+        return (R->closure[(size_t) c*R->words + d/64] >> (d % 64)) & 1;
+    }
+    return mayReach(R, c, d) && searchReach(R, c, d);
+}
+
+// Dynamic components ----------------------------------------------------------
+
+// Returns a structure that keeps the SCC's of G up to date as arcs are added to
+// and removed from G through addDynamicArc() and removeDynamicArc() (or their batch
+// versions). component[1..n] and count describe the current SCC's of G, numbered
+// 1..count in topological order as SCC() returns them.
+// G must not be changed by other means while the structure is in use.
+DynamicSCC newDynamicSCC(Graph G, const int *component, int count) {
+    if (G == NULL) {
+        fprintf(stderr, "Graph Error: calling newDynamicSCC() on NULL Graph reference\n");
+        exit(EXIT_FAILURE);
+    }
+    int n = getOrder(G);
+    if (component == NULL || count < 0) {
+        fprintf(stderr, "Graph Error: calling newDynamicSCC() with invalid component array\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int v = 1; v < n + 1; v += 1) {
+        if (component[v] < 1 || component[v] > count) {
+            fprintf(stderr, "Graph Error: calling newDynamicSCC() with invalid component array\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    buildAdjacency(G);
+    DynamicSCC D = malloc(sizeof(DynamicSCCObj));
+    D->G = G;
+    D->label = (int *) malloc((n + 1)*sizeof(int));
+    D->next_member = (int *) malloc((n + 1)*sizeof(int));
+    D->local = (int *) calloc(n + 1, sizeof(int));
+    D->at = (int *) malloc((n + 1)*sizeof(int));
+    D->forward = (int *) malloc((n + 1)*sizeof(int));
+    D->backward = (int *) malloc((n + 1)*sizeof(int));
+    D->places_of = (int *) malloc((n + 1)*sizeof(int));
+    D->sequence = (int *) malloc((n + 1)*sizeof(int));
+    D->out = (ArcBuffer *) calloc(count + 1, sizeof(ArcBuffer));
+    D->in = (ArcBuffer *) calloc(count + 1, sizeof(ArcBuffer));
+    D->leader = (int *) malloc((count + 1)*sizeof(int));
+    D->member = (int *) calloc(count + 1, sizeof(int));
+    D->position = (int *) malloc((count + 1)*sizeof(int));
+    D->forward_mark = (int *) calloc(count + 1, sizeof(int));
+    D->backward_mark = (int *) calloc(count + 1, sizeof(int));
+    if (D->label == NULL || D->next_member == NULL || D->local == NULL || D->at == NULL
+        || D->forward == NULL || D->backward == NULL || D->places_of == NULL || D->sequence == NULL
+        || D->out == NULL || D->in == NULL || D->leader == NULL || D->member == NULL
+        || D->position == NULL || D->forward_mark == NULL || D->backward_mark == NULL) {
+        fprintf(stderr, "Graph Error: out of memory in newDynamicSCC()\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int c = 0; c < count + 1; c += 1) {
+        D->leader[c] = c;
+        D->position[c] = c;
+        D->at[c] = c;
+    }
+    for (int v = 1; v < n + 1; v += 1) {
+        int c = component[v];
+        D->label[v] = c;
+        if (D->member[c] == 0) {
+            D->member[c] = v;
+            D->next_member[v] = v;
+        } else {
+            D->next_member[v] = D->next_member[D->member[c]];
+            D->next_member[D->member[c]] = v;
+        }
+    }
+
+    // Counts the arcs between components first, so that every arc list starts out
+    // as an exactly sized slice of one pool.
+    int arcs = 0;
+    for (int u = 1; u < n + 1; u += 1) {
+        for (int i = G->adj_offsets[u]; i < G->adj_offsets[u + 1]; i += 1) {
+            if (component[u] != component[G->adj[i]]) {
+                D->out[component[u]].capacity += 1;
+                D->in[component[G->adj[i]]].capacity += 1;
+                arcs += 1;
+            }
+        }
+    }
+    D->pool = (int *) malloc((arcs > 0 ? 4*(size_t) arcs : 1)*sizeof(int));
+    if (D->pool == NULL) {
+        fprintf(stderr, "Graph Error: out of memory in newDynamicSCC()\n");
+        exit(EXIT_FAILURE);
+    }
+    size_t next = 0;
+    for (int c = 1; c < count + 1; c += 1) {
+        D->out[c].arcs = D->pool + next;
+        next += 2*(size_t) D->out[c].capacity;
+        D->in[c].arcs = D->pool + next;
+        next += 2*(size_t) D->in[c].capacity;
+    }
+    for (int u = 1; u < n + 1; u += 1) {
+        for (int i = G->adj_offsets[u]; i < G->adj_offsets[u + 1]; i += 1) {
+            if (component[u] != component[G->adj[i]]) {
+                pushArc(&D->out[component[u]], u, G->adj[i]);
+                pushArc(&D->in[component[G->adj[i]]], u, G->adj[i]);
+            }
+        }
+    }
+
+    D->stamp = 0;
+    D->places = count;
+    D->labels = count;
+    D->capacity = count;
+    D->count = count;
+    return D;
+}
+
+// Frees all heap memory associated with *pD, and sets *pD to NULL.
+// The Graph it was created on is not freed.
+void freeDynamicSCC(DynamicSCC *pD) {
+    if (pD != NULL && *pD != NULL) {
+        DynamicSCC D = *pD;
+        for (int c = 1; c < D->labels + 1; c += 1) {
+            releaseArcs(&D->out[c]);
+            releaseArcs(&D->in[c]);
+        }
+        free(D->label);
+        free(D->next_member);
+        free(D->local);
+        free(D->pool);
+        free(D->out);
+        free(D->in);
+        free(D->leader);
+        free(D->member);
+        free(D->position);
+        free(D->forward_mark);
+        free(D->backward_mark);
+        free(D->at);
+        free(D->forward);
+        free(D->backward);
+        free(D->places_of);
+        free(D->sequence);
+        free(D);
+        *pD = NULL;
     }
     return;
-}
\ No newline at end of file
+}
+
+// Returns the number of SCC's of the Graph.
+int getComponentCount(DynamicSCC D) {
+    if (D == NULL) {
+        fprintf(stderr, "Graph Error: calling getComponentCount() on NULL DynamicSCC reference\n");
+        exit(EXIT_FAILURE);
+    }
+    return D->count;
+}
+
+// Returns a label for the SCC containing u: two vertices are in the same SCC iff
+// their labels are equal. Labels stay fixed until the component is merged or split.
+// Pre: 1 <= u <= getOrder(G)
+int getComponent(DynamicSCC D, int u) {
+    if (D == NULL) {
+        fprintf(stderr, "Graph Error: calling getComponent() on NULL DynamicSCC reference\n");
+        exit(EXIT_FAILURE);
+    }
+    if (u < 1 || u > getOrder(D->G)) {
+        fprintf(stderr, "Graph Error: calling getComponent() with invalid vertex\n");
+        exit(EXIT_FAILURE);
+    }
+    return findLeader(D, D->label[u]);
+}
+
+// Writes component ids 1, 2, ... in topological order into component[1..n], as
+// SCC() does, and returns the number of SCC's.
+int getComponents(DynamicSCC D, int *component) {
+    if (D == NULL) {
+        fprintf(stderr, "Graph Error: calling getComponents() on NULL DynamicSCC reference\n");
+        exit(EXIT_FAILURE);
+    }
+
+    int *id = D->places_of;
+    int count = 0;
+    for (int p = 1; p < D->places + 1; p += 1) {
+        if (D->at[p] != 0) {
+            count += 1;
+            id[p] = count;
+        }
+    }
+    for (int v = 1; v < getOrder(D->G) + 1; v += 1) {
+        component[v] = id[D->position[findLeader(D, D->label[v])]];
+    }
+    return count;
+}
+
+// Adds the arc u -> v to G and updates its SCC's. If the arc points backwards in
+// the topological order of the components, the components between the two ends
+// are searched forward from v's and backward from u's component (Pearce-Kelly);
+// components found by both searches lie on a new cycle and are merged, and the
+// searched components are reordered among the places they occupied.
+// Returns the number of SCC's that disappeared by merging.
+// Pre: 1 <= u <= getOrder(G)
+// Pre: 1 <= v <= getOrder(G)
+int addDynamicArc(DynamicSCC D, int u, int v) {
+    if (D == NULL) {
+        fprintf(stderr, "Graph Error: calling addDynamicArc() on NULL DynamicSCC reference\n");
+        exit(EXIT_FAILURE);
+    }
+    if (u < 1 || u > getOrder(D->G) || v < 1 || v > getOrder(D->G)) {
+        fprintf(stderr, "Graph Error: calling addDynamicArc() with invalid vertex/vertices\n");
+        exit(EXIT_FAILURE);
+    }
+
+    addArc(D->G, u, v);
+    int cu = findLeader(D, D->label[u]);
+    int cv = findLeader(D, D->label[v]);
+    if (cu == cv) {
+        return 0;
+    }
+    if (D->position[cu] < D->position[cv]) {
+        pushArc(&D->out[cu], u, v);
+        pushArc(&D->in[cv], u, v);
+        return 0;
+    }
+
+    nextStamp(D);
+    int low = D->position[cv];
+    int high = D->position[cu];
+    int forward_count = searchComponents(D, cv, true, low, high, D->forward);
+    int backward_count = searchComponents(D, cu, false, low, high, D->backward);
+    bool cycle = D->forward_mark[cu] == D->stamp;
+
+    // The places of all searched components, in order, are handed out again:
+    // first to the components that reach u (in their old order), then to the
+    // merged component, and last to the components reachable from v.
+    int places = 0;
+    int merged = 0;
+    int before = 0;
+    int after = 0;
+    for (int k = 0; k < backward_count; k += 1) {
+        int c = D->backward[k];
+        D->places_of[places++] = D->position[c];
+        if (D->forward_mark[c] != D->stamp) {
+            D->backward[before++] = D->position[c];
+        }
+    }
+    for (int k = 0; k < forward_count; k += 1) {
+        int c = D->forward[k];
+        if (D->backward_mark[c] != D->stamp) {
+            D->places_of[places++] = D->position[c];
+            D->forward[after++] = D->position[c];
+        } else {
+            D->sequence[merged++] = c;
+        }
+    }
+    qsort(D->places_of, places, sizeof(int), compareInts);
+    qsort(D->backward, before, sizeof(int), compareInts);
+    qsort(D->forward, after, sizeof(int), compareInts);
+
+    int rep = cu;
+    if (cycle) {
+        // The member with the most arcs keeps its label, so the fewest arcs move.
+        int best = -1;
+        for (int k = 0; k < merged; k += 1) {
+            int c = D->sequence[k];
+            if (D->out[c].count + D->in[c].count > best) {
+                best = D->out[c].count + D->in[c].count;
+                rep = c;
+            }
+        }
+        mergeComponents(D, rep, D->sequence, merged);
+    } else {
+        pushArc(&D->out[cu], u, v);
+        pushArc(&D->in[cv], u, v);
+    }
+
+    // Only ever moving the components that reach u down and the components
+    // reachable from v up keeps every arc to or from the rest in order. After a
+    // merge, the places freed in between are left empty.
+    int length = 0;
+    for (int k = 0; k < before; k += 1) {
+        D->sequence[length++] = D->at[D->backward[k]];
+    }
+    if (cycle) {
+        D->sequence[length++] = rep;
+    }
+    for (int k = length; k < places - after; k += 1) {
+        D->sequence[k] = 0;
+    }
+    for (int k = 0; k < after; k += 1) {
+        D->sequence[places - after + k] = D->at[D->forward[k]];
+    }
+    for (int k = 0; k < places; k += 1) {
+        D->at[D->places_of[k]] = D->sequence[k];
+        if (D->sequence[k] != 0) {
+            D->position[D->sequence[k]] = D->places_of[k];
+        }
+    }
+    return cycle ? merged - 1 : 0;
+}
+
+// Adds the m arcs (src[i], dst[i]) to G with addDynamicArc(), and returns the
+// number of SCC's that disappeared by merging.
+int addDynamicArcs(DynamicSCC D, const int *src, const int *dst, int m) {
+    if (D == NULL) {
+        fprintf(stderr, "Graph Error: calling addDynamicArcs() on NULL DynamicSCC reference\n");
+        exit(EXIT_FAILURE);
+    }
+    if (m < 0 || (m > 0 && (src == NULL || dst == NULL))) {
+        fprintf(stderr, "Graph Error: calling addDynamicArcs() with invalid arc arrays\n");
+        exit(EXIT_FAILURE);
+    }
+
+    int merged = 0;
+    for (int i = 0; i < m; i += 1) {
+        merged += addDynamicArc(D, src[i], dst[i]);
+    }
+    return merged;
+}
+
+// Removes the arcs (src[i], dst[i]) from G and updates its SCC's. Arcs between two
+// components are just dropped from the component DAG; a component that loses an
+// arc inside it has its SCC's recomputed on its own induced subgraph, and if it
+// falls apart, the pieces take its place in the topological order.
+// Returns the number of SCC's that appeared by splitting.
+// Pre: G contains each of the arcs, as many times as it is listed
+int removeDynamicArcs(DynamicSCC D, const int *src, const int *dst, int m) {
+    if (D == NULL) {
+        fprintf(stderr, "Graph Error: calling removeDynamicArcs() on NULL DynamicSCC reference\n");
+        exit(EXIT_FAILURE);
+    }
+    if (m < 0 || (m > 0 && (src == NULL || dst == NULL))) {
+        fprintf(stderr, "Graph Error: calling removeDynamicArcs() with invalid arc arrays\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Components that lost an internal arc are marked and listed in forward.
+    nextStamp(D);
+    int affected = 0;
+    for (int i = 0; i < m; i += 1) {
+        removeArc(D->G, src[i], dst[i]);
+        int cu = findLeader(D, D->label[src[i]]);
+        int cv = findLeader(D, D->label[dst[i]]);
+        if (cu != cv) {
+            dropArc(&D->out[cu], src[i], dst[i]);
+            dropArc(&D->in[cv], src[i], dst[i]);
+        } else if (D->forward_mark[cu] != D->stamp) {
+            D->forward_mark[cu] = D->stamp;
+            D->forward[affected++] = cu;
+        }
+    }
+    if (affected == 0) {
+        return 0;
+    }
+
+    buildAdjacency(D->G);
+    int n = getOrder(D->G);
+    int old_count = D->count;
+    int *pieces = (int *) malloc((n + 1)*sizeof(int));
+    int *piece_offsets = (int *) malloc((affected + 1)*sizeof(int));
+    if (pieces == NULL || piece_offsets == NULL) {
+        fprintf(stderr, "Graph Error: out of memory in removeDynamicArcs()\n");
+        exit(EXIT_FAILURE);
+    }
+    piece_offsets[0] = 0;
+    for (int a = 0; a < affected; a += 1) {
+        piece_offsets[a + 1] = piece_offsets[a] + splitComponent(D, D->forward[a], pieces + piece_offsets[a]);
+    }
+
+    // Rebuilds the order in one pass, replacing every split component by its pieces
+    // and closing up the places left empty by merges.
+    if (D->count > old_count) {
+        int *first_piece = (int *) calloc(D->labels + 1, sizeof(int));
+        if (first_piece == NULL) {
+            fprintf(stderr, "Graph Error: out of memory in removeDynamicArcs()\n");
+            exit(EXIT_FAILURE);
+        }
+        for (int a = 0; a < affected; a += 1) {
+            first_piece[D->forward[a]] = a + 1;
+        }
+        int places = 0;
+        for (int p = 1; p < D->places + 1; p += 1) {
+            int c = D->at[p];
+            if (c == 0) {
+                continue;
+            }
+            if (first_piece[c] == 0) {
+                D->sequence[places++] = c;
+            } else {
+                int a = first_piece[c] - 1;
+                for (int j = piece_offsets[a]; j < piece_offsets[a + 1]; j += 1) {
+                    D->sequence[places++] = pieces[j];
+                }
+            }
+        }
+        for (int p = 0; p < places; p += 1) {
+            D->at[p + 1] = D->sequence[p];
+            D->position[D->sequence[p]] = p + 1;
+        }
+        D->places = places;
+        free(first_piece);
+    }
+
+    free(pieces);
+    free(piece_offsets);
+    return D->count - old_count;
+}
+
+// Removes the arc u -> v from G with removeDynamicArcs(), and returns the number
+// of SCC's that appeared by splitting.
+// Pre: G contains the arc u -> v
+int removeDynamicArc(DynamicSCC D, int u, int v) {
+    return removeDynamicArcs(D, &u, &v, 1);
+}
@@ -1,3 +1,4 @@
+#include <stdint.h>
 #include "List.h"
 
 #ifndef GRAPH_H_INCLUDE_
@@ -13,10 +14,20 @@
 
 typedef struct GraphObj* Graph;
 
+typedef const struct GraphViewObj* GraphView;
+
+typedef struct ViewSearchObj* ViewSearch;
+
+typedef struct ReachIndexObj* ReachIndex;
+
+typedef struct DynamicSCCObj* DynamicSCC;
+
 // Constructors-Destructors ---------------------------------------------------
 
 Graph newGraph(int n);
 
+Graph newGraphFromEdges(int n, const int *src, const int *dst, int m);
+
 void freeGraph(Graph* pG);
 
 // Accessor functions -----------------------------------------------------------
@@ -31,20 +42,117 @@ int getDiscover(Graph G, int u);
 
 int getFinish(Graph G, int u);
 
+int getVisited(Graph G);
+
+int getMaxDepth(Graph G);
+
+int getNeighbors(Graph G, int u, const int **neighbors);
+
+int getInNeighbors(Graph G, int u, const int **neighbors);
+
 // Manipulation procedures ----------------------------------------------------
 
 void addEdge(Graph G, int u, int v);
 
 void addArc(Graph G, int u, int v);
 
+void removeEdge(Graph G, int u, int v);
+
+void removeArc(Graph G, int u, int v);
+
 void DFS(Graph G, List S);
 
+void DFSOrder(Graph G, List S);
+
+void DFSArray(Graph G, const int *order, int *finish_order);
+
+void DFSOrderArray(Graph G, const int *order, int *finish_order);
+
+void DFSReverse(Graph G, List S);
+
+void DFSReverseArray(Graph G, const int *order, int *finish_order);
+
+int DFSFrom(Graph G, int root, int *finish_order);
+
+int BFSFrom(Graph G, int source, int *reached);
+
+int SCC(Graph G, int *component);
+
+int parallelSCC(Graph G, int *component, int threads);
+
+int trimGraph(Graph G, int *component, int *sources);
+
 // Other operations ------------------------------------------------------------
 
 Graph transpose(Graph G);
 
 Graph copyGraph(Graph G);
 
+Graph inducedSubgraph(Graph G, const int *exclude, int *vertex_of);
+
+Graph condensation(Graph G, const int *component, int count, int *sizes);
+
 void printGraph(FILE* out, Graph G);
 
+void writeGraph(Writer W, Graph G);
+
+void saveGraph(Graph G, const char *path);
+
+Graph loadGraph(const char *path);
+
+// Read-only views -------------------------------------------------------------
+
+GraphView newGraphView(Graph G);
+
+void freeGraphView(GraphView *pV);
+
+int getViewOrder(GraphView V);
+
+int getViewSize(GraphView V);
+
+int getViewNeighbors(GraphView V, int u, const int **neighbors);
+
+int getViewInNeighbors(GraphView V, int u, const int **neighbors);
+
+ViewSearch newViewSearch(GraphView V);
+
+void freeViewSearch(ViewSearch *pS);
+
+int viewBFS(ViewSearch S, int source, bool reverse, const int **reached);
+
+int viewDFS(ViewSearch S, int root, bool reverse, const int **finished);
+
+bool viewReaches(ViewSearch S, int u, int v);
+
+int viewReachBatch(ViewSearch S, const int *sources, int k, bool reverse,
+                   const uint64_t **masks, const int **reached, int *counts);
+
+// Reachability index ----------------------------------------------------------
+
+ReachIndex newReachIndex(Graph G, const int *component, int count);
+
+void freeReachIndex(ReachIndex *pR);
+
+bool isReachable(ReachIndex R, int u, int v);
+
+// Dynamic components ----------------------------------------------------------
+
+DynamicSCC newDynamicSCC(Graph G, const int *component, int count);
+
+void freeDynamicSCC(DynamicSCC *pD);
+
+int getComponentCount(DynamicSCC D);
+
+int getComponent(DynamicSCC D, int u);
+
+int getComponents(DynamicSCC D, int *component);
+
+int addDynamicArc(DynamicSCC D, int u, int v);
+
+int addDynamicArcs(DynamicSCC D, const int *src, const int *dst, int m);
+
+int removeDynamicArc(DynamicSCC D, int u, int v);
+
+int removeDynamicArcs(DynamicSCC D, const int *src, const int *dst, int m);
+
 #endif
\ No newline at end of file
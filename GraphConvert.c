@@ -0,0 +1,19 @@
+#include "Graph.h"
+#include "EdgeReader.h"
+#include <stdlib.h>
+
+int main(int argc, char * argv[]) {
+
+    // Checks command line for correct number of arguments.
+    if (argc != 3) {
+        fprintf(stderr, "Usage: %s <text input file> <binary output file>\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    // Reads the edge-list text file and writes it back out in the binary graph format.
+    Graph G = readGraph(argv[1]);
+    saveGraph(G, argv[2]);
+    freeGraph(&G);
+
+    return 0;
+}
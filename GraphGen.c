@@ -0,0 +1,176 @@
+#include "Writer.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+// Writes synthetic graphs in the edge-list text format read by FindComponents.
+// Every shape is generated from a fixed seed, so the same arguments always give
+// the same file.
+
+#define DEFAULT_SEED 88172645463325252ULL
+
+// Returns the next value of the xorshift64 generator with the given state.
+uint64_t nextRandom(uint64_t *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+// Returns a uniformly distributed vertex in 1..n.
+int randomVertex(uint64_t *state, int n) {
+    return (int) (nextRandom(state) % (uint64_t) n) + 1;
+}
+
+// Writes the arc u -> v as one line to W.
+void writeArc(Writer W, int u, int v) {
+    writeInt(W, u);
+    writeChar(W, ' ');
+    writeInt(W, v);
+    writeChar(W, '\n');
+}
+
+// Path 1 -> 2 -> ... -> n: n singleton components and a DFS n vertices deep.
+void generatePath(Writer W, int n) {
+    for (int u = 1; u < n; u += 1) {
+        writeArc(W, u, u + 1);
+    }
+}
+
+// m arcs with both ends drawn uniformly at random (Erdos-Renyi G(n, m)).
+void generateRandom(Writer W, int n, long long m, uint64_t *state) {
+    for (long long i = 0; i < m; i += 1) {
+        int u = randomVertex(state, n);
+        writeArc(W, u, randomVertex(state, n));
+    }
+}
+
+// m arcs from the recursive R-MAT model with probabilities (0.57, 0.19, 0.19, 0.05),
+// which gives a skewed, power-law like degree distribution. Arcs that fall outside
+// 1..n when n is not a power of two are drawn again.
+void generateRMAT(Writer W, int n, long long m, uint64_t *state) {
+    int scale = 0;
+    while ((1LL << scale) < n) {
+        scale += 1;
+    }
+    for (long long i = 0; i < m; i += 1) {
+        long long u, v;
+        do {
+            u = v = 0;
+            for (int bit = 0; bit < scale; bit += 1) {
+                uint64_t r = nextRandom(state) % 100;
+                if (r >= 57 && r < 76) {
+                    v |= 1LL << bit;
+                } else if (r >= 76 && r < 95) {
+                    u |= 1LL << bit;
+                } else if (r >= 95) {
+                    u |= 1LL << bit;
+                    v |= 1LL << bit;
+                }
+            }
+        } while (u >= n || v >= n);
+        writeArc(W, (int) u + 1, (int) v + 1);
+    }
+}
+
+// A square grid with arcs both ways between horizontal and vertical neighbors:
+// one large component with long DFS paths. Vertices past the last full row are
+// left isolated.
+void generateGrid(Writer W, int n) {
+    int side = 1;
+    while ((long long) (side + 1)*(side + 1) <= n) {
+        side += 1;
+    }
+    for (int r = 0; r < side; r += 1) {
+        for (int c = 0; c < side; c += 1) {
+            int u = r*side + c + 1;
+            if (c + 1 < side) {
+                writeArc(W, u, u + 1);
+                writeArc(W, u + 1, u);
+            }
+            if (r + 1 < side) {
+                writeArc(W, u, u + side);
+                writeArc(W, u + side, u);
+            }
+        }
+    }
+}
+
+// One giant component on the first half of the vertices (a cycle plus random
+// chords), and the other half as singletons: the first of them only have arcs
+// into the giant component, the rest only arcs out of it.
+void generateGiant(Writer W, int n, long long m, uint64_t *state) {
+    int giant = (n + 1)/2;
+    int singletons = n - giant;
+    for (int u = 1; u < giant; u += 1) {
+        writeArc(W, u, u + 1);
+    }
+    if (giant > 1) {
+        writeArc(W, giant, 1);
+    }
+    long long chords = (m > n) ? (m - n)/2 : 0;
+    for (long long i = 0; i < chords; i += 1) {
+        int u = randomVertex(state, giant);
+        writeArc(W, u, randomVertex(state, giant));
+    }
+    long long links = (m > n) ? m - giant - chords : singletons;
+    for (long long i = 0; singletons > 0 && i < links; i += 1) {
+        int s = giant + (int) (i % singletons) + 1;
+        if (s - giant <= singletons/2) {
+            writeArc(W, s, randomVertex(state, giant));
+        } else {
+            writeArc(W, randomVertex(state, giant), s);
+        }
+    }
+}
+
+int main(int argc, char * argv[]) {
+
+    // Checks command line for correct number of arguments.
+    if (argc < 5 || argc > 6) {
+        fprintf(stderr, "Usage: %s <path|gnm|rmat|grid|giant> <vertices> <arcs> <output file> [seed]\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+    char *shape = argv[1];
+    int n = atoi(argv[2]);
+    long long m = atoll(argv[3]);
+    uint64_t state = (argc == 6) ? strtoull(argv[5], NULL, 10) : DEFAULT_SEED;
+    if (n < 1 || m < 0) {
+        fprintf(stderr, "GraphGen Error: need at least one vertex and a non-negative number of arcs\n");
+        exit(EXIT_FAILURE);
+    }
+    if (state == 0) {
+        state = DEFAULT_SEED;
+    }
+    if (strcmp(shape, "path") != 0 && strcmp(shape, "gnm") != 0 && strcmp(shape, "rmat") != 0
+        && strcmp(shape, "grid") != 0 && strcmp(shape, "giant") != 0) {
+        fprintf(stderr, "GraphGen Error: unknown shape %s\n", shape);
+        exit(EXIT_FAILURE);
+    }
+
+    FILE *out_file = fopen(argv[4], "w");
+    if (out_file == NULL) {
+        fprintf(stderr, "Unable to open file %s for writing\n", argv[4]);
+        exit(EXIT_FAILURE);
+    }
+    Writer W = newWriter(out_file);
+    writeInt(W, n);
+    writeChar(W, '\n');
+
+    if (strcmp(shape, "path") == 0) {
+        generatePath(W, n);
+    } else if (strcmp(shape, "gnm") == 0) {
+        generateRandom(W, n, m, &state);
+    } else if (strcmp(shape, "rmat") == 0) {
+        generateRMAT(W, n, m, &state);
+    } else if (strcmp(shape, "grid") == 0) {
+        generateGrid(W, n);
+    } else {
+        generateGiant(W, n, m, &state);
+    }
+
+    writeString(W, "0 0\n");
+    freeWriter(&W);
+    fclose(out_file);
+    return 0;
+}
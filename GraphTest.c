@@ -0,0 +1,85 @@
+#define _POSIX_C_SOURCE 200809L
+#include "Graph.h"
+#include <stdlib.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+// Tests of the Graph ADT. Graph errors end the process, so every case runs in a
+// child process and is checked by how that child exits.
+
+// Removes an arc once, then checks that the second removal of the same arc is
+// rejected by removeArc() itself rather than by a later read of the adjacency.
+void removeArcTwice(void) {
+    Graph G = newGraph(3);
+    addArc(G, 1, 2);
+    removeArc(G, 1, 2);
+    if (getSize(G) != 0) {
+        exit(2);
+    }
+    removeArc(G, 1, 2);
+    exit(0);
+}
+
+// Like removeArcTwice(), for an undirected edge.
+void removeEdgeTwice(void) {
+    Graph G = newGraph(3);
+    addEdge(G, 1, 2);
+    removeEdge(G, 2, 1);
+    removeEdge(G, 1, 2);
+    exit(0);
+}
+
+// A self-loop edge is two copies of one arc, so removing it as an edge after one
+// of them has been removed as an arc must be rejected.
+void removeSelfLoopTwice(void) {
+    Graph G = newGraph(3);
+    addEdge(G, 2, 2);
+    removeArc(G, 2, 2);
+    removeEdge(G, 2, 2);
+    exit(0);
+}
+
+// Removes both copies of a parallel arc, one staged and one already in the
+// adjacency, and checks that exactly the other arcs are left.
+void removeParallelArcs(void) {
+    Graph G = newGraph(3);
+    addArc(G, 1, 2);
+    addArc(G, 1, 3);
+    const int *neighbors;
+    getNeighbors(G, 1, &neighbors);
+    addArc(G, 1, 2);
+    removeArc(G, 1, 2);
+    removeArc(G, 1, 2);
+    int count = getNeighbors(G, 1, &neighbors);
+    bool ok = getSize(G) == 1 && count == 1 && neighbors[0] == 3;
+    freeGraph(&G);
+    exit(ok ? 0 : 1);
+}
+
+// Runs test in a child process and reports whether it exited with status expect.
+bool run(const char *name, void (*test)(void), int expect) {
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid < 0) {
+        fprintf(stderr, "Unable to start test %s\n", name);
+        exit(EXIT_FAILURE);
+    }
+    if (pid == 0) {
+        test();
+    }
+    int status;
+    waitpid(pid, &status, 0);
+    bool passed = WIFEXITED(status) && WEXITSTATUS(status) == expect;
+    printf("%s: %s\n", name, passed ? "passed" : "FAILED");
+    return passed;
+}
+
+int main(void) {
+    bool passed = true;
+    passed &= run("removeArcTwice", removeArcTwice, EXIT_FAILURE);
+    passed &= run("removeEdgeTwice", removeEdgeTwice, EXIT_FAILURE);
+    passed &= run("removeSelfLoopTwice", removeSelfLoopTwice, EXIT_FAILURE);
+    passed &= run("removeParallelArcs", removeParallelArcs, 0);
+    return passed ? 0 : EXIT_FAILURE;
+}
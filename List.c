@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include "List.h"
+#include "Writer.h"
 
 // structs --------------------------------------------------------------------
 
@@ -15,48 +16,110 @@ typedef struct NodeObj {
    Node prev;
 } NodeObj;
 
+// private NodeBlock type
+typedef struct NodeBlockObj* NodeBlock;
+
+// private NodeBlockObj type: a slab of Nodes owned by one List.
+typedef struct NodeBlockObj {
+   NodeBlock next;
+   int capacity;
+   NodeObj nodes[];
+} NodeBlockObj;
+
+#define FIRST_BLOCK_NODES 16
+#define MAX_BLOCK_NODES 4096
+
 // private ListObj type
+// Nodes are carved out of the slabs in blocks (the newest slab first, with
+// block_used of its Nodes handed out so far); deleted Nodes go onto free_nodes
+// for reuse, and all slabs are released together by clear() and freeList().
 typedef struct ListObj {
    Node front;
    Node back;
    Node cursor;
    int length;
    int index;
+   NodeBlock blocks;
+   int block_used;
+   Node free_nodes;
 } ListObj;
 
 // Constructors-Destructors ---------------------------------------------------
 
-// Returns reference to new Node object. Initializes next, prev, and data fields.
-Node newNode(int data) {
-   Node N = malloc(sizeof(NodeObj));
+// Returns reference to new Node object from L's slabs. Initializes next, prev, and data fields.
+Node newNode(List L, int data) {
+   Node N;
+   if (L->free_nodes != NULL) {
+      N = L->free_nodes;
+      L->free_nodes = N->next;
+   } else {
+      if (L->blocks == NULL || L->block_used == L->blocks->capacity) {
+         int capacity = (L->blocks == NULL) ? FIRST_BLOCK_NODES : 2*L->blocks->capacity;
+         if (capacity > MAX_BLOCK_NODES) {
+            capacity = MAX_BLOCK_NODES;
+         }
+         NodeBlock B = malloc(sizeof(NodeBlockObj) + capacity*sizeof(NodeObj));
+         if (B == NULL) {
+            fprintf(stderr, "List Error: out of memory allocating List nodes\n");
+            exit(EXIT_FAILURE);
+         }
+         B->capacity = capacity;
+         B->next = L->blocks;
+         L->blocks = B;
+         L->block_used = 0;
+      }
+      N = &L->blocks->nodes[L->block_used];
+      L->block_used += 1;
+   }
    N->data = data;
    N->next = N->prev = NULL;
    return N;
 }
 
-// Frees heap memory pointed to by *pN, sets *pN to NULL.
-void freeNode(Node* pN){
+// Returns the Node pointed to by *pN to L's free list, sets *pN to NULL.
+void freeNode(List L, Node* pN){
    if (pN != NULL && *pN != NULL) {
-      free(*pN);
+      (*pN)->next = L->free_nodes;
+      L->free_nodes = *pN;
       *pN = NULL;
    }
 }
 
+// Frees the slabs of L. If keep_newest is true, the newest (largest) slab is
+// kept, emptied, for reuse.
+void freeBlocks(List L, bool keep_newest) {
+   NodeBlock B = L->blocks;
+   if (keep_newest && B != NULL) {
+      B = B->next;
+      L->blocks->next = NULL;
+   } else {
+      L->blocks = NULL;
+   }
+   while (B != NULL) {
+      NodeBlock next = B->next;
+      free(B);
+      B = next;
+   }
+   L->block_used = 0;
+   L->free_nodes = NULL;
+}
+
 // Returns reference to new empty List object.
 List newList(void) {
    List L = malloc(sizeof(ListObj));
    L->front = L->back = L->cursor = NULL;
    L->length = 0;
    L->index = -1;
+   L->blocks = NULL;
+   L->block_used = 0;
+   L->free_nodes = NULL;
    return L;
 }
 
 // Frees all heap memory associated with List *pL, and sets *pL to NULL.
 void freeList(List* pL){
    if(pL != NULL && *pL != NULL) { 
-      while(length(*pL) != 0) { 
-         deleteFront(*pL);
-      }
+      freeBlocks(*pL, false);
       free(*pL);
       *pL = NULL;
    }
@@ -66,25 +129,30 @@ void freeList(List* pL){
 
 // Returns the number of elements in L.
 int length(List L) {
+#ifndef NDEBUG
    if (L == NULL) {
       fprintf(stderr, "List Error: calling length() on NULL List reference\n");
       exit(EXIT_FAILURE);
    }
+#endif
    return L->length;
 }
 
 // Returns index of cursor element if defined, -1 otherwise.
 int index(List L) {
+#ifndef NDEBUG
    if (L == NULL) {
       fprintf(stderr, "List Error: calling index() on NULL List reference\n");
       exit(EXIT_FAILURE);
    }
+#endif
    return L->index;
 }
 
 // Returns front element of L. 
 // Pre: length() > 0
 int front(List L) {
+#ifndef NDEBUG
    if (L == NULL) {
       fprintf(stderr, "List Error: calling front() on NULL List reference\n");
       exit(EXIT_FAILURE);
@@ -93,12 +161,14 @@ int front(List L) {
       fprintf(stderr, "List Error: calling front() on List with no elements\n");
       exit(EXIT_FAILURE);
    }
+#endif
    return L->front->data;
 }
 
 // Returns back element of L. 
 // Pre: length()>0
 int back(List L) {
+#ifndef NDEBUG
    if (L == NULL) {
       fprintf(stderr, "List Error: calling back() on NULL List reference\n");
       exit(EXIT_FAILURE);
@@ -107,12 +177,14 @@ int back(List L) {
       fprintf(stderr, "List Error: calling back() on List with no elements\n");
       exit(EXIT_FAILURE);
    }
+#endif
    return L->back->data;
 }
 
 // Returns cursor element of L. 
 // Pre: length()>0, index()>=0
 int get(List L) {
+#ifndef NDEBUG
    if (L == NULL) {
       fprintf(stderr, "List Error: calling get() on NULL List reference\n");
       exit(EXIT_FAILURE);
@@ -125,6 +197,7 @@ int get(List L) {
       fprintf(stderr, "List Error: calling get() on List with undefined cursor element\n");
       exit(EXIT_FAILURE);
    }
+#endif
    return L->cursor->data;
 }
 
@@ -164,16 +237,17 @@ void clear(List L) {
       exit(EXIT_FAILURE);
    }
 
-   while (length(L) != 0) {
-      deleteFront(L);
-   }
-   
+   // Releases every Node at once instead of deleting them one by one.
+   freeBlocks(L, true);
+   L->front = L->back = L->cursor = NULL;
+   L->length = 0;
    L->index = -1;
 }
 
 // Overwrites the cursor element’s data with x.
 // Pre: length()>0, index()>=0
 void set(List L, int x) {
+#ifndef NDEBUG
    if (L == NULL) {
       fprintf(stderr, "List Error: calling set() on NULL List reference\n");
       exit(EXIT_FAILURE);
@@ -186,15 +260,18 @@ void set(List L, int x) {
       fprintf(stderr, "List Error: calling set() on List with undefined cursor element\n");
       exit(EXIT_FAILURE);
    }
+#endif
    L->cursor->data = x;
 }
 
 // If L is non-empty, sets cursor under the front element, otherwise does nothing.
 void moveFront(List L) {
+#ifndef NDEBUG
    if (L == NULL) {
       fprintf(stderr, "List Error: calling moveFront() on NULL List reference\n");
       exit(EXIT_FAILURE);
    }
+#endif
    
    if (L->length == 0) {
       return;
@@ -206,10 +283,12 @@ void moveFront(List L) {
 
 // If L is non-empty, sets cursor under the back element, otherwise does nothing.
 void moveBack(List L) {
+#ifndef NDEBUG
    if (L == NULL) {
       fprintf(stderr, "List Error: calling moveFront() on NULL List reference\n");
       exit(EXIT_FAILURE);
    }
+#endif
    
    if (L->length == 0) {
       return;
@@ -222,10 +301,12 @@ void moveBack(List L) {
 // If cursor is defined and not at front, move cursor one step toward the front of L; 
 // if cursor is defined and at front, cursor becomes undefined; if cursor is undefined do nothing
 void movePrev(List L) {
+#ifndef NDEBUG
    if (L == NULL) {
       fprintf(stderr, "List Error: calling movePrev() on NULL List reference\n");
       exit(EXIT_FAILURE);
    }
+#endif
 
    if (L->cursor == NULL) {
       return;
@@ -241,10 +322,12 @@ void movePrev(List L) {
 // If cursor is defined and not at back, move cursor one step toward the back of L;
 // if cursor is defined and at back, cursor becomes undefined; if cursor is undefined do nothing
 void moveNext(List L) {
+#ifndef NDEBUG
    if (L == NULL) {
       fprintf(stderr, "List Error: calling moveNext() on NULL List reference\n");
       exit(EXIT_FAILURE);
    }
+#endif
 
    if (L->cursor == NULL) {
       return;
@@ -259,12 +342,13 @@ void moveNext(List L) {
 
 // Insert new element into L. If L is non-empty, insertion takes place before front element.
 void prepend(List L, int x) {
-   Node N = newNode(x);
+   Node N = NULL;
 
    if (L == NULL) {
       fprintf(stderr, "List Error: calling prepend() on NULL List reference\n");
       exit(EXIT_FAILURE);
    }
+   N = newNode(L, x);
 
    if (L->length == 0) {
       L->front = L->back = N;
@@ -281,12 +365,13 @@ void prepend(List L, int x) {
 
 // Insert new element into L. If L is non-empty, insertion takes place after back element.
 void append(List L, int x) {
-   Node N = newNode(x);
+   Node N = NULL;
 
    if (L == NULL) {
       fprintf(stderr, "List Error: calling append() on NULL List reference\n");
       exit(EXIT_FAILURE);
    }
+   N = newNode(L, x);
 
    if (L->length == 0) {
       L->front = L->back = N;
@@ -303,7 +388,7 @@ void append(List L, int x) {
 // Insert new element before cursor.
 // Pre: length()>0, index()>=0
 void insertBefore(List L, int x) {
-   Node N = newNode(x);
+   Node N = NULL;
 
    if (L == NULL) {
       fprintf(stderr, "List Error: calling insertBefore() on NULL List reference\n");
@@ -317,6 +402,7 @@ void insertBefore(List L, int x) {
       fprintf(stderr, "List Error: calling insertBefore() on List with undefined cursor element\n");
       exit(EXIT_FAILURE);
    }
+   N = newNode(L, x);
 
    if (L->cursor == L->front) {
       L->cursor->prev = N;
@@ -336,7 +422,7 @@ void insertBefore(List L, int x) {
 // Insert new element after cursor.
 // Pre: length()>0, index()>=0
 void insertAfter(List L, int x) {
-   Node N = newNode(x);
+   Node N = NULL;
 
    if (L == NULL) {
       fprintf(stderr, "List Error: calling insertBefore() on NULL List reference\n");
@@ -350,6 +436,7 @@ void insertAfter(List L, int x) {
       fprintf(stderr, "List Error: calling insertBefore() on List with undefined cursor element\n");
       exit(EXIT_FAILURE);
    }
+   N = newNode(L, x);
 
    if (L->cursor == L->back) {
       L->cursor->next = N;
@@ -394,7 +481,7 @@ void deleteFront(List L) {
 
    L->length -= 1;
    L->index -= 1;
-   freeNode(&N);
+   freeNode(L, &N);
 }
 
 // Delete the back element. 
@@ -426,7 +513,7 @@ void deleteBack(List L) {
    }
 
    L->length -= 1;
-   freeNode(&N);
+   freeNode(L, &N);
 }
 
 // Delete cursor element, making cursor undefined.
@@ -464,7 +551,7 @@ void delete(List L) {
    L->cursor = NULL;
    L->index = -1;
    L->length -= 1;
-   freeNode(&N);
+   freeNode(L, &N);
 }
 
 // Other operations ------------------------------------------------------------
@@ -484,6 +571,21 @@ void printList(FILE* out, List L) {
    }
 }
 
+// Same as printList(), but appends to the buffered Writer W.
+void writeList(Writer W, List L) {
+   Node N = NULL;
+
+   if(L == NULL) {
+      fprintf(stderr, "List Error: calling writeList() on NULL List reference\n");
+      exit(EXIT_FAILURE);
+   }
+
+   for (N = L->front; N != NULL; N = N->next) {
+      writeInt(W, N->data);
+      writeChar(W, ' ');
+   }
+}
+
 // Returns a new List representing the same integer sequence as L.
 // The cursor in the new list is undefined, regardless of the state of the cursor in L.
 // The state of L is unchanged.
@@ -502,3 +604,33 @@ List copyList(List L) {
 
    return L2;
 }
+
+// Iteration -------------------------------------------------------------------
+
+// Starts iterator I at the front of L.
+void beginList(List L, ListIterator* I) {
+   if (L == NULL || I == NULL) {
+      fprintf(stderr, "List Error: calling beginList() on NULL List or ListIterator reference\n");
+      exit(EXIT_FAILURE);
+   }
+   I->list = L;
+   I->node = L->front;
+   I->offset = 0;
+   I->next = I->end = I->buffer;
+}
+
+// Copies the data of up to LIST_ITERATOR_BATCH Nodes into I's buffer, so the
+// inline nextElement() only follows the Node links once per batch.
+bool refillIterator(ListIterator* I) {
+   const NodeObj* N = I->node;
+   int count = 0;
+   while (N != NULL && count < LIST_ITERATOR_BATCH) {
+      I->buffer[count] = N->data;
+      count += 1;
+      N = N->next;
+   }
+   I->node = N;
+   I->next = I->buffer;
+   I->end = I->buffer + count;
+   return count > 0;
+}
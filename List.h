@@ -8,6 +8,23 @@
 // Exported type --------------------------------------------------------------
 typedef struct ListObj* List;
 
+// The buffered writer of Writer.h, named here only so writeList() can take one.
+typedef struct WriterObj* Writer;
+
+#define LIST_ITERATOR_BATCH 64
+
+// A forward iterator over the elements of a List that leaves its cursor alone.
+// Elements are handed out of the run next .. end - 1; list, node, offset and
+// buffer belong to the List implementation, which refills the run in batches.
+typedef struct ListIterator {
+   const int* next;
+   const int* end;
+   List list;
+   const void* node;
+   int offset;
+   int buffer[LIST_ITERATOR_BATCH];
+} ListIterator;
+
 
 // Constructors-Destructors ---------------------------------------------------
 
@@ -114,9 +131,36 @@ void delete(List L);
 // with front on left.
 void printList(FILE* out, List L);
 
+// writeList()
+// Same as printList(), but appends to the buffered Writer W.
+void writeList(Writer W, List L);
+
 // copyList()
 // Returns a new List representing the same integer sequence as L. The cursor in the new list is undefined, 
 // regardless of the state of the cursor in L. The state of L is unchanged.
 List copyList(List L);
 
+// Iteration -------------------------------------------------------------------
+
+// beginList()
+// Starts iterator I at the front of L. L must not be changed while I is in use.
+void beginList(List L, ListIterator* I);
+
+// refillIterator()
+// Loads the next run of elements into I; returns false if none are left.
+// Called by nextElement(), which handles the common case inline.
+bool refillIterator(ListIterator* I);
+
+// nextElement()
+// Stores the next element in *x and returns true, or returns false once every
+// element of the List has been handed out. Pre: beginList() was called on I.
+static inline bool nextElement(ListIterator* I, int* x) {
+   if (I->next == I->end && !refillIterator(I)) {
+      return false;
+   }
+   *x = *I->next;
+   I->next += 1;
+   return true;
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,504 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "List.h"
+#include "Writer.h"
+
+// Array-backed implementation of the List ADT in List.h. The elements live in a
+// growable circular buffer (a deque), so prepend(), append(), deleteFront() and
+// deleteBack() are amortized O(1), index() and cursor moves are O(1), and
+// insertions or deletions in the middle shift the shorter side of the buffer.
+// Build with "make LIST=ListArray" to use it in place of List.c.
+
+#define FIRST_CAPACITY 16
+
+// structs --------------------------------------------------------------------
+
+// private ListObj type
+// Element i (0 <= i < length) is stored at data[(head + i) & (capacity - 1)];
+// capacity is always a power of two. The cursor is just the element index.
+typedef struct ListObj {
+   int* data;
+   int capacity;
+   int head;
+   int length;
+   int index;
+} ListObj;
+
+// Private Helper Functions ---------------------------------------------------
+
+// Returns a pointer to element i of L.
+static inline int* slot(List L, int i) {
+   return &L->data[(L->head + i) & (L->capacity - 1)];
+}
+
+// Doubles the capacity of L if it is full, unrolling the buffer so head is 0.
+void reserve(List L) {
+   if (L->length < L->capacity) {
+      return;
+   }
+   int capacity = 2*L->capacity;
+   int* data = malloc(capacity*sizeof(int));
+   if (data == NULL) {
+      fprintf(stderr, "List Error: out of memory growing List\n");
+      exit(EXIT_FAILURE);
+   }
+   for (int i = 0; i < L->length; i += 1) {
+      data[i] = *slot(L, i);
+   }
+   free(L->data);
+   L->data = data;
+   L->capacity = capacity;
+   L->head = 0;
+}
+
+// Opens a gap at element position i (0 <= i <= length) and stores x there,
+// shifting whichever side of the buffer is shorter.
+void insertAt(List L, int i, int x) {
+   reserve(L);
+   if (i < L->length - i) {
+      L->head = (L->head - 1) & (L->capacity - 1);
+      for (int k = 0; k < i; k += 1) {
+         *slot(L, k) = *slot(L, k + 1);
+      }
+   } else {
+      for (int k = L->length; k > i; k -= 1) {
+         *slot(L, k) = *slot(L, k - 1);
+      }
+   }
+   *slot(L, i) = x;
+   L->length += 1;
+}
+
+// Removes element position i (0 <= i < length), shifting whichever side is shorter.
+void removeAt(List L, int i) {
+   if (i < L->length - 1 - i) {
+      for (int k = i; k > 0; k -= 1) {
+         *slot(L, k) = *slot(L, k - 1);
+      }
+      L->head = (L->head + 1) & (L->capacity - 1);
+   } else {
+      for (int k = i; k < L->length - 1; k += 1) {
+         *slot(L, k) = *slot(L, k + 1);
+      }
+   }
+   L->length -= 1;
+}
+
+// Constructors-Destructors ---------------------------------------------------
+
+// Returns reference to new empty List object.
+List newList(void) {
+   List L = malloc(sizeof(ListObj));
+   if (L != NULL) {
+      L->data = malloc(FIRST_CAPACITY*sizeof(int));
+   }
+   if (L == NULL || L->data == NULL) {
+      fprintf(stderr, "List Error: out of memory in newList()\n");
+      exit(EXIT_FAILURE);
+   }
+   L->capacity = FIRST_CAPACITY;
+   L->head = 0;
+   L->length = 0;
+   L->index = -1;
+   return L;
+}
+
+// Frees all heap memory associated with List *pL, and sets *pL to NULL.
+void freeList(List* pL){
+   if(pL != NULL && *pL != NULL) { 
+      free((*pL)->data);
+      free(*pL);
+      *pL = NULL;
+   }
+}
+
+// // Access functions -----------------------------------------------------------
+
+// Returns the number of elements in L.
+int length(List L) {
+#ifndef NDEBUG
+   if (L == NULL) {
+      fprintf(stderr, "List Error: calling length() on NULL List reference\n");
+      exit(EXIT_FAILURE);
+   }
+#endif
+   return L->length;
+}
+
+// Returns index of cursor element if defined, -1 otherwise.
+int index(List L) {
+#ifndef NDEBUG
+   if (L == NULL) {
+      fprintf(stderr, "List Error: calling index() on NULL List reference\n");
+      exit(EXIT_FAILURE);
+   }
+#endif
+   return L->index;
+}
+
+// Returns front element of L. 
+// Pre: length() > 0
+int front(List L) {
+#ifndef NDEBUG
+   if (L == NULL) {
+      fprintf(stderr, "List Error: calling front() on NULL List reference\n");
+      exit(EXIT_FAILURE);
+   }
+   if (length(L) < 1) {
+      fprintf(stderr, "List Error: calling front() on List with no elements\n");
+      exit(EXIT_FAILURE);
+   }
+#endif
+   return *slot(L, 0);
+}
+
+// Returns back element of L. 
+// Pre: length()>0
+int back(List L) {
+#ifndef NDEBUG
+   if (L == NULL) {
+      fprintf(stderr, "List Error: calling back() on NULL List reference\n");
+      exit(EXIT_FAILURE);
+   }
+   if (length(L) < 1) {
+      fprintf(stderr, "List Error: calling back() on List with no elements\n");
+      exit(EXIT_FAILURE);
+   }
+#endif
+   return *slot(L, L->length - 1);
+}
+
+// Returns cursor element of L. 
+// Pre: length()>0, index()>=0
+int get(List L) {
+#ifndef NDEBUG
+   if (L == NULL) {
+      fprintf(stderr, "List Error: calling get() on NULL List reference\n");
+      exit(EXIT_FAILURE);
+   }
+   if (length(L) < 1) {
+      fprintf(stderr, "List Error: calling get() on List with no elements\n");
+      exit(EXIT_FAILURE);
+   }
+   if (index(L) < 0) {
+      fprintf(stderr, "List Error: calling get() on List with undefined cursor element\n");
+      exit(EXIT_FAILURE);
+   }
+#endif
+   return *slot(L, L->index);
+}
+
+// equals()
+// Returns true iff Lists A and B are in same state, and returns false otherwise.
+bool equals(List A, List B) {
+   if (A == NULL || B == NULL) {
+      fprintf(stderr, "List Error: calling equals() on NULL List reference\n");
+      exit(EXIT_FAILURE);
+   }
+
+   bool equals = A->length == B->length;
+   for (int i = 0; equals && i < A->length; i += 1) {
+      equals = (*slot(A, i) == *slot(B, i));
+   }
+   return equals;
+}
+
+// Manipulation procedures ----------------------------------------------------
+
+// Resets L to its original empty state.
+void clear(List L) {
+   if (L == NULL) {
+      fprintf(stderr, "List Error: calling clear() on NULL List reference\n");
+      exit(EXIT_FAILURE);
+   }
+   L->head = 0;
+   L->length = 0;
+   L->index = -1;
+}
+
+// Overwrites the cursor element’s data with x.
+// Pre: length()>0, index()>=0
+void set(List L, int x) {
+#ifndef NDEBUG
+   if (L == NULL) {
+      fprintf(stderr, "List Error: calling set() on NULL List reference\n");
+      exit(EXIT_FAILURE);
+   }
+   if (length(L) < 1) {
+      fprintf(stderr, "List Error: calling set() on List with no elements\n");
+      exit(EXIT_FAILURE);
+   }
+   if (index(L) < 0) {
+      fprintf(stderr, "List Error: calling set() on List with undefined cursor element\n");
+      exit(EXIT_FAILURE);
+   }
+#endif
+   *slot(L, L->index) = x;
+}
+
+// If L is non-empty, sets cursor under the front element, otherwise does nothing.
+void moveFront(List L) {
+#ifndef NDEBUG
+   if (L == NULL) {
+      fprintf(stderr, "List Error: calling moveFront() on NULL List reference\n");
+      exit(EXIT_FAILURE);
+   }
+#endif
+   if (L->length > 0) {
+      L->index = 0;
+   }
+}
+
+// If L is non-empty, sets cursor under the back element, otherwise does nothing.
+void moveBack(List L) {
+#ifndef NDEBUG
+   if (L == NULL) {
+      fprintf(stderr, "List Error: calling moveBack() on NULL List reference\n");
+      exit(EXIT_FAILURE);
+   }
+#endif
+   if (L->length > 0) {
+      L->index = L->length - 1;
+   }
+}
+
+// If cursor is defined and not at front, move cursor one step toward the front of L; 
+// if cursor is defined and at front, cursor becomes undefined; if cursor is undefined do nothing
+void movePrev(List L) {
+#ifndef NDEBUG
+   if (L == NULL) {
+      fprintf(stderr, "List Error: calling movePrev() on NULL List reference\n");
+      exit(EXIT_FAILURE);
+   }
+#endif
+   if (L->index >= 0) {
+      L->index -= 1;
+   }
+}
+
+// If cursor is defined and not at back, move cursor one step toward the back of L;
+// if cursor is defined and at back, cursor becomes undefined; if cursor is undefined do nothing
+void moveNext(List L) {
+#ifndef NDEBUG
+   if (L == NULL) {
+      fprintf(stderr, "List Error: calling moveNext() on NULL List reference\n");
+      exit(EXIT_FAILURE);
+   }
+#endif
+   if (L->index >= 0) {
+      L->index = (L->index == L->length - 1) ? -1 : L->index + 1;
+   }
+}
+
+// Insert new element into L. If L is non-empty, insertion takes place before front element.
+// As with the linked List, inserting into an empty List places the cursor on the new element.
+void prepend(List L, int x) {
+   if (L == NULL) {
+      fprintf(stderr, "List Error: calling prepend() on NULL List reference\n");
+      exit(EXIT_FAILURE);
+   }
+   reserve(L);
+   L->head = (L->head - 1) & (L->capacity - 1);
+   L->data[L->head] = x;
+   L->length += 1;
+   if (L->length == 1) {
+      L->index = 0;
+   } else if (L->index >= 0) {
+      L->index += 1;
+   }
+}
+
+// Insert new element into L. If L is non-empty, insertion takes place after back element.
+// As with the linked List, inserting into an empty List places the cursor on the new element.
+void append(List L, int x) {
+   if (L == NULL) {
+      fprintf(stderr, "List Error: calling append() on NULL List reference\n");
+      exit(EXIT_FAILURE);
+   }
+   reserve(L);
+   *slot(L, L->length) = x;
+   L->length += 1;
+   if (L->length == 1) {
+      L->index = 0;
+   }
+}
+
+// Insert new element before cursor.
+// Pre: length()>0, index()>=0
+void insertBefore(List L, int x) {
+   if (L == NULL) {
+      fprintf(stderr, "List Error: calling insertBefore() on NULL List reference\n");
+      exit(EXIT_FAILURE);
+   }
+   if (length(L) < 1) {
+      fprintf(stderr, "List Error: calling insertBefore() on List with no elements\n");
+      exit(EXIT_FAILURE);
+   }
+   if (index(L) < 0) {
+      fprintf(stderr, "List Error: calling insertBefore() on List with undefined cursor element\n");
+      exit(EXIT_FAILURE);
+   }
+   insertAt(L, L->index, x);
+   L->index += 1;
+}
+
+// Insert new element after cursor.
+// Pre: length()>0, index()>=0
+void insertAfter(List L, int x) {
+   if (L == NULL) {
+      fprintf(stderr, "List Error: calling insertAfter() on NULL List reference\n");
+      exit(EXIT_FAILURE);
+   }
+   if (length(L) < 1) {
+      fprintf(stderr, "List Error: calling insertAfter() on List with no elements\n");
+      exit(EXIT_FAILURE);
+   }
+   if (index(L) < 0) {
+      fprintf(stderr, "List Error: calling insertAfter() on List with undefined cursor element\n");
+      exit(EXIT_FAILURE);
+   }
+   insertAt(L, L->index + 1, x);
+}
+
+// Delete the front element. 
+// Pre: length()>0
+void deleteFront(List L) {
+   if (L == NULL) {
+      fprintf(stderr, "List Error: calling deleteFront() on NULL List reference\n");
+      exit(EXIT_FAILURE);
+   }
+   if (length(L) < 1) {
+      fprintf(stderr, "List Error: calling deleteFront() on List with no elements\n");
+      exit(EXIT_FAILURE);
+   }
+   L->head = (L->head + 1) & (L->capacity - 1);
+   L->length -= 1;
+   if (L->index >= 0) {
+      L->index -= 1;
+   }
+}
+
+// Delete the back element. 
+// Pre: length()>0
+void deleteBack(List L) {
+   if (L == NULL) {
+      fprintf(stderr, "List Error: calling deleteBack() on NULL List reference\n");
+      exit(EXIT_FAILURE);
+   }
+   if (length(L) < 1) {
+      fprintf(stderr, "List Error: calling deleteBack() on List with no elements\n");
+      exit(EXIT_FAILURE);
+   }
+   if (L->index == L->length - 1) {
+      L->index = -1;
+   }
+   L->length -= 1;
+}
+
+// Delete cursor element, making cursor undefined.
+// Pre: length()>0, index()>=0
+void delete(List L) {
+   if (L == NULL) {
+      fprintf(stderr, "List Error: calling delete() on NULL List reference\n");
+      exit(EXIT_FAILURE);
+   }
+   if (length(L) < 1) {
+      fprintf(stderr, "List Error: calling delete() on List with no elements\n");
+      exit(EXIT_FAILURE);
+   }
+   if (index(L) < 0) {
+      fprintf(stderr, "List Error: calling delete() on List with undefined cursor element\n");
+      exit(EXIT_FAILURE);
+   }
+   removeAt(L, L->index);
+   L->index = -1;
+}
+
+// Other operations ------------------------------------------------------------
+
+// Prints to the file pointed to by out, a string representation of L consisting of a space separated sequence of integers,
+// with front on left.
+void printList(FILE* out, List L) {
+   if(L == NULL) {
+      fprintf(stderr, "List Error: calling printList() on NULL List reference\n");
+      exit(EXIT_FAILURE);
+   }
+
+   for (int i = 0; i < L->length; i += 1) {
+      fprintf(out, "%d ", *slot(L, i));
+   }
+}
+
+// Same as printList(), but appends to the buffered Writer W.
+void writeList(Writer W, List L) {
+   if(L == NULL) {
+      fprintf(stderr, "List Error: calling writeList() on NULL List reference\n");
+      exit(EXIT_FAILURE);
+   }
+
+   for (int i = 0; i < L->length; i += 1) {
+      writeInt(W, *slot(L, i));
+      writeChar(W, ' ');
+   }
+}
+
+// Returns a new List representing the same integer sequence as L.
+// The cursor in the new list is undefined, regardless of the state of the cursor in L.
+// The state of L is unchanged.
+List copyList(List L) {
+   if(L == NULL) {
+      fprintf(stderr, "List Error: calling copyList() on NULL List reference\n");
+      exit(EXIT_FAILURE);
+   }
+
+   List L2 = malloc(sizeof(ListObj));
+   if (L2 != NULL) {
+      L2->data = malloc(L->capacity*sizeof(int));
+   }
+   if (L2 == NULL || L2->data == NULL) {
+      fprintf(stderr, "List Error: out of memory in copyList()\n");
+      exit(EXIT_FAILURE);
+   }
+   L2->capacity = L->capacity;
+   L2->head = 0;
+   L2->length = L->length;
+   L2->index = -1;
+   for (int i = 0; i < L->length; i += 1) {
+      L2->data[i] = *slot(L, i);
+   }
+   return L2;
+}
+
+// Iteration -------------------------------------------------------------------
+
+// Starts iterator I at the front of L.
+void beginList(List L, ListIterator* I) {
+   if (L == NULL || I == NULL) {
+      fprintf(stderr, "List Error: calling beginList() on NULL List or ListIterator reference\n");
+      exit(EXIT_FAILURE);
+   }
+   I->list = L;
+   I->node = NULL;
+   I->offset = 0;
+   I->next = I->end = I->buffer;
+}
+
+// Points I at the next run of elements that is contiguous in the buffer of L:
+// the whole List takes at most two runs, and nothing is copied.
+bool refillIterator(ListIterator* I) {
+   List L = I->list;
+   if (I->offset >= L->length) {
+      return false;
+   }
+   int start = (L->head + I->offset) & (L->capacity - 1);
+   int run = L->capacity - start;
+   if (run > L->length - I->offset) {
+      run = L->length - I->offset;
+   }
+   I->next = &L->data[start];
+   I->end = I->next + run;
+   I->offset += run;
+   return true;
+}
@@ -0,0 +1,116 @@
+#define _POSIX_C_SOURCE 200809L
+#include "Graph.h"
+#include "EdgeReader.h"
+#include "Writer.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Times the List operations of the List-based FindComponents pipeline (building
+// the vertex stack, both DFS passes over it, and collecting and printing the
+// components) with whichever List backend this program was linked against.
+// "make benchList" builds and runs it once per backend.
+
+#ifndef LIST_BACKEND
+#define LIST_BACKEND "unknown"
+#endif
+
+#define BENCH_VERTICES 1000000
+#define BENCH_DEGREE 4
+#define BENCH_ROUNDS 5
+
+// Returns the current monotonic time in seconds.
+double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec*1e-9;
+}
+
+// Returns a random digraph on n vertices with degree*n arcs, the same for every run.
+Graph randomGraph(int n, int degree) {
+    int m = n*degree;
+    int *src = (int *) malloc(m*sizeof(int));
+    int *dst = (int *) malloc(m*sizeof(int));
+    unsigned long long state = 88172645463325252ULL;
+    for (int i = 0; i < m; i += 1) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        src[i] = (int) (state % n) + 1;
+        dst[i] = (int) ((state >> 32) % n) + 1;
+    }
+    Graph G = newGraphFromEdges(n, src, dst, m);
+    free(src);
+    free(dst);
+    return G;
+}
+
+int main(int argc, char * argv[]) {
+    if (argc > 3) {
+        fprintf(stderr, "Usage: %s [<input file> [rounds]]\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+    Graph G = (argc > 1) ? readGraph(argv[1]) : randomGraph(BENCH_VERTICES, BENCH_DEGREE);
+    int rounds = (argc > 2) ? atoi(argv[2]) : BENCH_ROUNDS;
+    int n = getOrder(G);
+
+    FILE *sink = fopen("/dev/null", "w");
+    if (sink == NULL) {
+        fprintf(stderr, "Unable to open /dev/null for writing\n");
+        exit(EXIT_FAILURE);
+    }
+    Writer W = newWriter(sink);
+
+    double best_build = 0.0, best_dfs = 0.0, best_collect = 0.0;
+    int scc_counter = 0;
+    for (int r = 0; r < rounds; r += 1) {
+        double start = now();
+        List S = newList();
+        for (int v = 1; v < n + 1; v += 1) {
+            append(S, v);
+        }
+        double built = now();
+
+        DFS(G, S);
+        DFSReverse(G, S);
+        double searched = now();
+
+        // Walks S from the back, gathering each DFS tree of the reversed pass into scc.
+        List scc = newList();
+        scc_counter = 0;
+        moveBack(S);
+        while (index(S) != -1) {
+            int vertex = get(S);
+            prepend(scc, vertex);
+            if (getParent(G, vertex) == NIL) {
+                scc_counter += 1;
+                writeList(W, scc);
+                writeChar(W, '\n');
+                clear(scc);
+            }
+            movePrev(S);
+        }
+        double collected = now();
+        freeList(&scc);
+        freeList(&S);
+
+        if (r == 0 || built - start < best_build) {
+            best_build = built - start;
+        }
+        if (r == 0 || searched - built < best_dfs) {
+            best_dfs = searched - built;
+        }
+        if (r == 0 || collected - searched < best_collect) {
+            best_collect = collected - searched;
+        }
+    }
+
+    printf("%-7s n=%d m=%d components=%d  build %.4fs  dfs %.4fs  collect %.4fs  total %.4fs\n",
+           LIST_BACKEND, n, getSize(G), scc_counter, best_build, best_dfs, best_collect,
+           best_build + best_dfs + best_collect);
+
+    freeWriter(&W);
+    fclose(sink);
+    freeGraph(&G);
+    return 0;
+}
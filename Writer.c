@@ -0,0 +1,116 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Writer.h"
+
+#define WRITER_BUFFER (1 << 16)
+#define MAX_INT_DIGITS 12
+
+// structs --------------------------------------------------------------------
+
+// private WriterObj type
+typedef struct WriterObj {
+   FILE* out;
+   char* buffer;
+   int used;
+} WriterObj;
+
+// Constructors-Destructors ---------------------------------------------------
+
+// Returns reference to new Writer object that writes to out.
+Writer newWriter(FILE* out) {
+   if (out == NULL) {
+      fprintf(stderr, "Writer Error: calling newWriter() on NULL FILE reference\n");
+      exit(EXIT_FAILURE);
+   }
+   Writer W = malloc(sizeof(WriterObj));
+   if (W != NULL) {
+      W->buffer = malloc(WRITER_BUFFER);
+   }
+   if (W == NULL || W->buffer == NULL) {
+      fprintf(stderr, "Writer Error: out of memory in newWriter()\n");
+      exit(EXIT_FAILURE);
+   }
+   W->out = out;
+   W->used = 0;
+   return W;
+}
+
+// Flushes and frees all heap memory associated with Writer *pW, and sets *pW to NULL.
+void freeWriter(Writer* pW) {
+   if (pW != NULL && *pW != NULL) {
+      flushWriter(*pW);
+      free((*pW)->buffer);
+      free(*pW);
+      *pW = NULL;
+   }
+}
+
+// Output operations ----------------------------------------------------------
+
+// Appends the decimal representation of x to W's buffer.
+void writeInt(Writer W, int x) {
+   char digits[MAX_INT_DIGITS];
+   int k = MAX_INT_DIGITS;
+   unsigned int magnitude = (x < 0) ? 0u - (unsigned int) x : (unsigned int) x;
+
+   if (W == NULL) {
+      fprintf(stderr, "Writer Error: calling writeInt() on NULL Writer reference\n");
+      exit(EXIT_FAILURE);
+   }
+   if (W->used > WRITER_BUFFER - MAX_INT_DIGITS) {
+      flushWriter(W);
+   }
+
+   // Converts the digits from least to most significant, then copies them out.
+   do {
+      digits[--k] = (char) ('0' + magnitude % 10);
+      magnitude /= 10;
+   } while (magnitude != 0);
+   if (x < 0) {
+      digits[--k] = '-';
+   }
+   memcpy(W->buffer + W->used, digits + k, MAX_INT_DIGITS - k);
+   W->used += MAX_INT_DIGITS - k;
+}
+
+// Appends the character c to W's buffer.
+void writeChar(Writer W, char c) {
+   if (W == NULL) {
+      fprintf(stderr, "Writer Error: calling writeChar() on NULL Writer reference\n");
+      exit(EXIT_FAILURE);
+   }
+   if (W->used == WRITER_BUFFER) {
+      flushWriter(W);
+   }
+   W->buffer[W->used] = c;
+   W->used += 1;
+}
+
+// Appends the null-terminated string s to W's buffer.
+void writeString(Writer W, const char* s) {
+   if (W == NULL) {
+      fprintf(stderr, "Writer Error: calling writeString() on NULL Writer reference\n");
+      exit(EXIT_FAILURE);
+   }
+   for (; *s != '\0'; s += 1) {
+      if (W->used == WRITER_BUFFER) {
+         flushWriter(W);
+      }
+      W->buffer[W->used] = *s;
+      W->used += 1;
+   }
+}
+
+// Writes out everything buffered in W.
+void flushWriter(Writer W) {
+   if (W == NULL) {
+      fprintf(stderr, "Writer Error: calling flushWriter() on NULL Writer reference\n");
+      exit(EXIT_FAILURE);
+   }
+   if (W->used > 0 && fwrite(W->buffer, 1, W->used, W->out) != (size_t) W->used) {
+      fprintf(stderr, "Writer Error: unable to write output\n");
+      exit(EXIT_FAILURE);
+   }
+   W->used = 0;
+}
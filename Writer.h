@@ -0,0 +1,41 @@
+#ifndef WRITER_H_INCLUDE_
+#define WRITER_H_INCLUDE_
+
+#include <stdio.h>
+
+
+// Exported type --------------------------------------------------------------
+typedef struct WriterObj* Writer;
+
+
+// Constructors-Destructors ---------------------------------------------------
+
+// newWriter()
+// Creates and returns a buffered writer that writes to out in large blocks.
+Writer newWriter(FILE* out);
+
+// freeWriter()
+// Flushes *pW, frees all heap memory associated with it, and sets *pW to NULL.
+// Does not close the underlying FILE.
+void freeWriter(Writer* pW);
+
+
+// Output operations ----------------------------------------------------------
+
+// writeInt()
+// Appends the decimal representation of x to W's buffer.
+void writeInt(Writer W, int x);
+
+// writeChar()
+// Appends the character c to W's buffer.
+void writeChar(Writer W, char c);
+
+// writeString()
+// Appends the null-terminated string s to W's buffer.
+void writeString(Writer W, const char* s);
+
+// flushWriter()
+// Writes out everything buffered in W.
+void flushWriter(Writer W);
+
+#endif